@@ -0,0 +1,246 @@
+#pragma once
+
+#include   <gmpxx.h>
+#include     <omp.h>
+#include <algorithm>
+#include     <array>
+#include       <bit>
+#include     <cmath>
+#include  <iostream>
+#include       <map>
+#include    <string>
+#include    <vector>
+
+#include    <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include   <unistd.h>
+
+inline std::array<int, 256> reverse_map(const std::string& character_map, unsigned long base) {
+    std::array<int, 256> values; values.fill(-1);
+
+    for (size_t k = std::min<size_t>(base, character_map.size()); k-- > 0;) values[(unsigned char)character_map[k]] = k;
+
+    return values;
+}
+
+inline size_t chunk_digits(unsigned long base) {
+    size_t digits = 0; for (uint64_t power = 1; power <= UINT64_MAX / base; power *= base) digits++; return std::max<size_t>(digits, 1);
+}
+
+inline std::vector<mpz_class> base_powers(unsigned long base, size_t levels) {
+    static std::map<unsigned long, std::vector<mpz_class>> cache; std::vector<mpz_class> powers;
+
+    #pragma omp critical(base_powers)
+    {
+        std::vector<mpz_class>& cached = cache[base]; if (cached.empty()) cached.emplace_back(), mpz_ui_pow_ui(cached.back().get_mpz_t(), base, chunk_digits(base));
+
+        while (cached.size() < levels) cached.push_back(cached.back() * cached.back());
+
+        powers.assign(cached.begin(), cached.begin() + levels);
+    }
+
+    return powers;
+}
+
+inline mpz_class digits_to_number(const char* digits, size_t count, const std::array<int, 256>& values, unsigned long base, size_t chunk, const std::vector<mpz_class>& powers) {
+    if (count <= chunk) {
+        uint64_t value = 0; for (size_t k = 0; k < count; k++) value = value * base + values[(unsigned char)digits[k]]; return mpz_class(value);
+    }
+
+    size_t level = 0; while (chunk << (level + 1) < count) level++; size_t low_count = chunk << level; mpz_class high, low;
+
+    #pragma omp task shared(low, values, powers) if(count > 65536)
+    low = digits_to_number(digits + count - low_count, low_count, values, base, chunk, powers);
+
+    high = digits_to_number(digits, count - low_count, values, base, chunk, powers);
+
+    #pragma omp taskwait
+    high *= powers.at(level), high += low; return high;
+}
+
+inline void fill_digits(const mpz_class& number, size_t level, char* out, const std::string& character_map, unsigned long base, size_t chunk, const std::vector<mpz_class>& powers) {
+    if (level == 0) {
+        uint64_t value = number.get_ui(); for (size_t k = chunk; k-- > 0;) out[k] = character_map[value % base], value /= base; return;
+    }
+
+    mpz_class high, low; mpz_tdiv_qr(high.get_mpz_t(), low.get_mpz_t(), number.get_mpz_t(), powers.at(level - 1).get_mpz_t());
+
+    #pragma omp task shared(high, character_map, powers) if((chunk << level) > 65536)
+    fill_digits(high, level - 1, out, character_map, base, chunk, powers);
+
+    fill_digits(low, level - 1, out + (chunk << (level - 1)), character_map, base, chunk, powers);
+
+    #pragma omp taskwait
+}
+
+inline void append_digits(const mpz_class& number, size_t level, std::string& out, const std::string& character_map, unsigned long base, size_t chunk, const std::vector<mpz_class>& powers) {
+    if (level == 0) {
+        char digits[64]; size_t count = 0; for (uint64_t value = number.get_ui(); value; value /= base) digits[count++] = character_map[value % base]; while (count) out.push_back(digits[--count]); return;
+    }
+
+    if (number < powers.at(level - 1)) return append_digits(number, level - 1, out, character_map, base, chunk, powers);
+
+    mpz_class high, low; mpz_tdiv_qr(high.get_mpz_t(), low.get_mpz_t(), number.get_mpz_t(), powers.at(level - 1).get_mpz_t());
+
+    append_digits(high, level - 1, out, character_map, base, chunk, powers); size_t offset = out.size(); out.resize(offset + (chunk << (level - 1)));
+
+    fill_digits(low, level - 1, out.data() + offset, character_map, base, chunk, powers);
+}
+
+inline mpz_class base_to_decimal(const std::string& number, mpz_class base, const std::string& character_map) {
+    mpz_class converted_number; if (base < 2 || !base.fits_ulong_p()) throw std::runtime_error("BASE '" + base.get_str() + "' IS NOT SUPPORTED");
+
+    unsigned long radix = base.get_ui(); std::array<int, 256> values = reverse_map(character_map, radix); size_t chunk = chunk_digits(radix), levels = 1;
+
+    for (char digit : number) if (values[(unsigned char)digit] < 0) throw std::runtime_error("THE NUMBER '" + number + "' IS DEFINITELY NOT IN BASE '" + base.get_str() + "' WITH '" + character_map + "' CHARACTER MAP");
+
+    if (std::has_single_bit(radix)) {
+
+        size_t bits = std::countr_zero(radix); std::vector<uint64_t> words(number.size() * bits / 64 + 1, 0);
+
+        for (size_t k = 0; k < number.size(); k++) {
+            uint64_t value = values[(unsigned char)number[number.size() - 1 - k]], position = k * bits; words[position / 64] |= value << position % 64; if (position % 64 + bits > 64) words[position / 64 + 1] |= value >> (64 - position % 64);
+        }
+
+        mpz_import(converted_number.get_mpz_t(), words.size(), -1, 8, 0, 0, words.data()); return converted_number;
+    }
+
+    if (number.size() <= chunk) return digits_to_number(number.data(), number.size(), values, radix, chunk, {});
+
+    while (chunk << levels < number.size()) levels++;
+
+    std::vector<mpz_class> powers = base_powers(radix, levels);
+
+    #pragma omp parallel if(number.size() > 65536)
+    #pragma omp single
+    converted_number = digits_to_number(number.data(), number.size(), values, radix, chunk, powers);
+
+    return converted_number;
+}
+
+inline std::string decimal_to_base(mpz_class number, unsigned int base, const std::string& character_map) {
+    std::string converted_number; size_t chunk = chunk_digits(base), levels = 0;
+
+    if (base < 2 || base > character_map.size()) throw std::runtime_error("BASE '" + std::to_string(base) + "' IS NOT SUPPORTED WITH '" + character_map + "' CHARACTER MAP");
+
+    if (number < 0) throw std::runtime_error("THE NUMBER '" + number.get_str() + "' IS NEGATIVE");
+
+    if (number == 0) return converted_number;
+
+    if (std::has_single_bit(base)) {
+
+        size_t bits = std::countr_zero(base), count = (mpz_sizeinbase(number.get_mpz_t(), 2) + bits - 1) / bits; std::vector<uint64_t> words(count * bits / 64 + 2, 0); mpz_export(words.data(), nullptr, -1, 8, 0, 0, number.get_mpz_t()); converted_number.resize(count);
+
+        for (size_t k = 0; k < count; k++) {
+            uint64_t position = k * bits, value = words[position / 64] >> position % 64; if (position % 64 + bits > 64) value |= words[position / 64 + 1] << (64 - position % 64); converted_number[count - 1 - k] = character_map[value & (base - 1)];
+        }
+
+        return converted_number;
+    }
+
+    while ((double)(chunk << levels) * log2(base) <= mpz_sizeinbase(number.get_mpz_t(), 2) + 1) levels++;
+
+    std::vector<mpz_class> powers = base_powers(base, levels);
+
+    #pragma omp parallel if(mpz_sizeinbase(number.get_mpz_t(), 2) > 262144)
+    #pragma omp single
+    append_digits(number, levels, converted_number, character_map, base, chunk, powers);
+
+    return converted_number;
+}
+
+struct Batch {
+    unsigned int from, to; std::string input, output; std::array<int, 256> values; size_t from64, from128, to64; uint64_t to_power;
+};
+
+inline Batch make_batch(unsigned int from, unsigned int to, const std::string& input, const std::string& output) {
+    Batch batch = {from, to, input, output, reverse_map(input, from), 0, 0, chunk_digits(to), 1};
+
+    if (from < 2 || to < 2 || to > output.size()) throw std::runtime_error("BASE '" + std::to_string(to) + "' IS NOT SUPPORTED WITH '" + output + "' CHARACTER MAP");
+
+    for (uint64_t power = 1; power <= UINT64_MAX / from; power *= from) batch.from64++;
+
+    for (unsigned __int128 power = 1; power <= ~(unsigned __int128)0 / from; power *= from) batch.from128++;
+
+    for (size_t k = 0; k < batch.to64; k++) batch.to_power *= to;
+
+    return batch;
+}
+
+inline void convert_line(const char* line, size_t length, const Batch& batch, std::string& out) {
+    unsigned __int128 value = 0; uint64_t low = 0; char digits[160]; size_t count = 0, k = 0;
+
+    if (length > batch.from128) {
+        out += decimal_to_base(base_to_decimal(std::string(line, length), batch.from, batch.input), batch.to, batch.output), out.push_back('\n'); return;
+    }
+
+    for (; k < length && k < batch.from64; k++) {
+        int digit = batch.values[(unsigned char)line[k]]; if (digit < 0) break; low = low * batch.from + digit;
+    }
+
+    for (value = low; k < length; k++) {
+        int digit = batch.values[(unsigned char)line[k]]; if (digit < 0) break; value = value * batch.from + digit;
+    }
+
+    if (k < length) base_to_decimal(std::string(line, length), batch.from, batch.input);
+
+    if (std::has_single_bit(batch.to)) for (unsigned int bits = std::countr_zero(batch.to); value; value >>= bits) digits[count++] = batch.output[(uint64_t)value & (batch.to - 1)];
+
+    else {
+        for (; value >> 64; value /= batch.to_power) for (uint64_t rest = value % batch.to_power, j = 0; j < batch.to64; j++) digits[count++] = batch.output[rest % batch.to], rest /= batch.to;
+
+        for (low = value; low; low /= batch.to) digits[count++] = batch.output[low % batch.to];
+    }
+
+    while (count) out.push_back(digits[--count]);
+
+    out.push_back('\n');
+}
+
+inline size_t convert_batch(const char* data, size_t size, bool last, const Batch& batch, std::string& error) {
+    std::vector<std::pair<size_t, size_t>> blocks; const char* newline = (const char*)memrchr(data, '\n', size); size_t end = last ? size : newline ? newline - data + 1 : 0;
+
+    for (size_t begin = 0; begin < end;) {
+        const char* next = begin + (1 << 20) < end ? (const char*)memchr(data + begin + (1 << 20), '\n', end - begin - (1 << 20)) : nullptr; size_t stop = next ? next - data + 1 : end; blocks.emplace_back(begin, stop), begin = stop;
+    }
+
+    #pragma omp parallel for ordered schedule(dynamic, 1)
+    for (size_t b = 0; b < blocks.size(); b++) {
+
+        std::string out, failure; out.reserve(2 * (blocks[b].second - blocks[b].first));
+
+        try {
+            for (size_t begin = blocks[b].first, stop; begin < blocks[b].second; begin = stop + 1) {
+                const char* next = (const char*)memchr(data + begin, '\n', blocks[b].second - begin); stop = next ? next - data : blocks[b].second; convert_line(data + begin, stop - begin, batch, out);
+            }
+        } catch (const std::runtime_error& exception) {failure = exception.what();}
+
+        #pragma omp ordered
+        if (error.empty()) std::cout.write(out.data(), out.size()), error = failure;
+    }
+
+    return end;
+}
+
+inline void convert_file(const std::string& filename, const Batch& batch) {
+    std::string error; std::vector<char> buffer(1 << 26); size_t filled = 0, read = 0;
+
+    if (filename != "-") {
+        int file = open(filename.c_str(), O_RDONLY); struct stat status; if (file < 0 || fstat(file, &status)) throw std::runtime_error("COULD NOT OPEN THE BATCH FILE");
+
+        if (status.st_size == 0) {close(file); return;}
+
+        const char* map = (const char*)mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0); close(file); if (map == MAP_FAILED) throw std::runtime_error("COULD NOT MAP THE BATCH FILE");
+
+        madvise((void*)map, status.st_size, MADV_SEQUENTIAL), convert_batch(map, status.st_size, true, batch, error), munmap((void*)map, status.st_size);
+    }
+
+    else do {
+        read = fread(buffer.data() + filled, 1, buffer.size() - filled, stdin), filled += read; if (filled == buffer.size() && !memchr(buffer.data(), '\n', filled)) buffer.resize(2 * buffer.size());
+
+        size_t consumed = convert_batch(buffer.data(), filled, read == 0, batch, error); std::copy(buffer.begin() + consumed, buffer.begin() + filled, buffer.begin()), filled -= consumed;
+    } while (read && error.empty());
+
+    std::cout.flush(); if (!error.empty()) throw std::runtime_error(error);
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include  <gmpxx.h>
+#include    <omp.h>
+#include      <bit>
+#include <iostream>
+#include   <string>
+#include    <tuple>
+#include   <vector>
+
+struct Jump {
+    uint64_t a, b, peak_a, peak_b; unsigned int steps;
+};
+
+struct CollatzTables {
+    unsigned int k; std::vector<unsigned int> length; std::vector<uint64_t> maximum; std::vector<Jump> jump, drop;
+};
+
+inline CollatzTables make_collatz_tables(unsigned int k, unsigned int bits) {
+    CollatzTables tables = {k, std::vector<unsigned int>(1UL << bits, 1), std::vector<uint64_t>(1UL << bits, 1), std::vector<Jump>(1UL << k), std::vector<Jump>(1UL << k, {0, 0, 0, 0, 0})};
+
+    for (uint64_t n = 2; n < tables.length.size(); n++) {
+        uint64_t x = n, peak = n; unsigned int steps = 0; while (x >= n) x = x % 2 ? 3 * x + 1 : x / 2, peak = std::max(peak, x), steps++; tables.length[n] = steps + tables.length[x], tables.maximum[n] = std::max(peak, tables.maximum[x]);
+    }
+
+    for (uint64_t r = 0; r < tables.jump.size(); r++) {
+        Jump jump = {1UL << k, r, 1UL << k, r, 0};
+
+        for (unsigned int i = 0; i < k; i++) {
+            if (jump.b % 2) jump.peak_a = std::max(jump.peak_a, 3 * jump.a), jump.peak_b = std::max(jump.peak_b, 3 * jump.b + 1), jump.a = 3 * jump.a / 2, jump.b = (3 * jump.b + 1) / 2, jump.steps += 2;
+            else jump.a /= 2, jump.b /= 2, jump.steps++;
+
+            jump.peak_a = std::max(jump.peak_a, jump.a), jump.peak_b = std::max(jump.peak_b, jump.b);
+
+            if (!tables.drop[r].steps && jump.a < 1UL << k && jump.a + jump.b < (1UL << k) + r) tables.drop[r] = jump;
+        }
+
+        tables.jump[r] = jump;
+    }
+
+    return tables;
+}
+
+inline const CollatzTables& collatz_tables() {
+    static const CollatzTables tables = make_collatz_tables(16, 20); return tables;
+}
+
+inline mpz_class to_mpz(unsigned __int128 x) {
+    mpz_class n; mpz_import(n.get_mpz_t(), 2, -1, 8, 0, 0, &x); return n;
+}
+
+inline unsigned __int128 to_u128(const mpz_class& n) {
+    unsigned __int128 x = 0; if (mpz_sizeinbase(n.get_mpz_t(), 2) > 128) return ~x; mpz_export(&x, nullptr, -1, 8, 0, 0, n.get_mpz_t()); return x;
+}
+
+inline bool sweep_length(unsigned __int128 x, const CollatzTables& tables, unsigned long& length) {
+    uint64_t mask = (1UL << tables.k) - 1; length = 0;
+
+    while (x >= tables.length.size()) {
+
+        if (x >> 80) {
+            if (x >> 125) return false;
+
+            x = x % 2 ? 3 * x + 1 : x / 2, length++; continue;
+        }
+
+        const Jump& jump = tables.jump[(uint64_t)x & mask]; x = (x >> tables.k) * jump.a + jump.b, length += jump.steps;
+    }
+
+    length += tables.length[x]; return true;
+}
+
+inline bool sweep_maximum(unsigned __int128 x, const CollatzTables& tables, unsigned __int128& maximum) {
+    uint64_t mask = (1UL << tables.k) - 1; maximum = x;
+
+    while (x >= tables.length.size()) {
+
+        const Jump& jump = tables.jump[(uint64_t)x & mask];
+
+        if (x >> 80 || (x >> tables.k) * jump.peak_a + jump.peak_b > maximum) {
+            if (x >> 125) return false;
+
+            x = x % 2 ? 3 * x + 1 : x / 2, maximum = std::max(maximum, x); continue;
+        }
+
+        x = (x >> tables.k) * jump.a + jump.b;
+    }
+
+    maximum = std::max<unsigned __int128>(maximum, tables.maximum[x]); return true;
+}
+
+inline bool below_record(uint64_t n, uint64_t start, unsigned __int128 record, const CollatzTables& tables) {
+    uint64_t mask = (1UL << tables.k) - 1; unsigned __int128 x = n, q = x >> tables.k; const Jump& drop = tables.drop[n & mask];
+
+    if (n > record) return false;
+
+    if (n >= tables.length.size() && drop.steps && q * drop.peak_a + drop.peak_b <= record) {
+        unsigned __int128 m = q * drop.a + drop.b; if (m >= start || (m < tables.length.size() && tables.maximum[m] <= record)) return true;
+    }
+
+    while (x >= tables.length.size() && (x >= n || x < start)) {
+
+        const Jump& jump = tables.jump[(uint64_t)x & mask];
+
+        if (x >> 80 || (x >> tables.k) * jump.peak_a + jump.peak_b > record) {
+            if (x >> 125 || (x = x % 2 ? 3 * x + 1 : x / 2) > record) return false;
+        } else x = (x >> tables.k) * jump.a + jump.b;
+    }
+
+    return x >= tables.length.size() || tables.maximum[x] <= record;
+}
+
+inline unsigned long series_length(mpz_class n) {
+    const CollatzTables& tables = collatz_tables(); uint64_t mask = (1UL << tables.k) - 1; unsigned long length = 0, rest;
+
+    if (n < 1) throw std::runtime_error("THE NUMBER MUST BE POSITIVE");
+
+    while (mpz_sizeinbase(n.get_mpz_t(), 2) > 100 || !sweep_length(to_u128(n), tables, rest)) {
+
+        if (mpz_even_p(n.get_mpz_t())) {
+            unsigned long zeros = mpz_scan1(n.get_mpz_t(), 0); mpz_tdiv_q_2exp(n.get_mpz_t(), n.get_mpz_t(), zeros), length += zeros; continue;
+        }
+
+        const Jump& jump = tables.jump[mpz_getlimbn(n.get_mpz_t(), 0) & mask]; mpz_tdiv_q_2exp(n.get_mpz_t(), n.get_mpz_t(), tables.k), mpz_mul_ui(n.get_mpz_t(), n.get_mpz_t(), jump.a), mpz_add_ui(n.get_mpz_t(), n.get_mpz_t(), jump.b), length += jump.steps;
+    }
+
+    return length + rest;
+}
+
+inline mpz_class series_maximum(mpz_class n) {
+    const CollatzTables& tables = collatz_tables(); uint64_t mask = (1UL << tables.k) - 1; unsigned __int128 rest; mpz_class maximum = n;
+
+    if (n < 1) throw std::runtime_error("THE NUMBER MUST BE POSITIVE");
+
+    while (mpz_sizeinbase(n.get_mpz_t(), 2) > 100 || !sweep_maximum(to_u128(n), tables, rest)) {
+
+        const Jump& jump = tables.jump[mpz_getlimbn(n.get_mpz_t(), 0) & mask];
+
+        if (mpz_even_p(n.get_mpz_t())) mpz_tdiv_q_2exp(n.get_mpz_t(), n.get_mpz_t(), mpz_scan1(n.get_mpz_t(), 0));
+
+        else if (mpz_sizeinbase(n.get_mpz_t(), 2) + std::bit_width(jump.peak_a) + 1 < mpz_sizeinbase(maximum.get_mpz_t(), 2) + tables.k) {
+            mpz_tdiv_q_2exp(n.get_mpz_t(), n.get_mpz_t(), tables.k), mpz_mul_ui(n.get_mpz_t(), n.get_mpz_t(), jump.a), mpz_add_ui(n.get_mpz_t(), n.get_mpz_t(), jump.b);
+        }
+
+        else if (mpz_mul_ui(n.get_mpz_t(), n.get_mpz_t(), 3), mpz_add_ui(n.get_mpz_t(), n.get_mpz_t(), 1), n > maximum) maximum = n;
+    }
+
+    return std::max(maximum, to_mpz(rest));
+}
+
+inline void write_series(mpz_class n, std::ostream& stream) {
+    std::string buffer; std::vector<char> digits;
+
+    if (n < 1) throw std::runtime_error("THE NUMBER MUST BE POSITIVE");
+
+    while (true) {
+
+        digits.resize(std::max(digits.size(), mpz_sizeinbase(n.get_mpz_t(), 10) + 2)), mpz_get_str(digits.data(), 10, n.get_mpz_t()), buffer.append(digits.data()).push_back('\n');
+
+        if (buffer.size() >= 1 << 20) stream.write(buffer.data(), buffer.size()), buffer.clear();
+
+        if (n == 1) break;
+
+        if (mpz_odd_p(n.get_mpz_t())) mpz_mul_ui(n.get_mpz_t(), n.get_mpz_t(), 3), mpz_add_ui(n.get_mpz_t(), n.get_mpz_t(), 1);
+
+        else mpz_tdiv_q_2exp(n.get_mpz_t(), n.get_mpz_t(), 1);
+    }
+
+    stream.write(buffer.data(), buffer.size()).flush();
+}
+
+enum class Statistic {
+    Histogram, Length, Maximum
+};
+
+inline Statistic sweep_statistic(const std::string& name) {
+    if (name == "histogram") return Statistic::Histogram;
+
+    if (name == "length"   ) return Statistic::Length;
+
+    if (name == "maximum"  ) return Statistic::Maximum;
+
+    throw std::runtime_error("UNKNOWN STATISTIC '" + name + "'");
+}
+
+inline void sweep(uint64_t start, uint64_t end, const std::string& name) {
+    const CollatzTables& tables = collatz_tables(); std::vector<unsigned long> histogram; unsigned long record_length = 0; mpz_class record_maximum = 0; Statistic statistic = sweep_statistic(name);
+
+    start = std::max<uint64_t>(start, 1); uint64_t chunks = end < start ? 0 : (end - start) / 65536 + 1;
+
+    #pragma omp parallel for ordered schedule(dynamic, 1)
+    for (uint64_t c = 0; c < chunks; c++) {
+
+        uint64_t from = start + 65536 * c, to = std::min(end - from, 65535UL) + from; std::vector<std::tuple<uint64_t, unsigned long, mpz_class>> candidates; std::vector<unsigned long> counts;
+
+        unsigned long length_threshold; unsigned __int128 maximum_threshold; mpz_class big_threshold;
+
+        #pragma omp critical
+        length_threshold = record_length, big_threshold = record_maximum, maximum_threshold = to_u128(record_maximum);
+
+        for (uint64_t n = from; n <= to && n >= from; n++) {
+
+            unsigned long length = 0; unsigned __int128 maximum = 0; mpz_class big;
+
+            if (statistic == Statistic::Maximum) {
+
+                if (below_record(n, start, maximum_threshold, tables)) continue;
+
+                if (sweep_maximum(n, tables, maximum)) big = to_mpz(maximum); else big = series_maximum(n), maximum = to_u128(big);
+
+                if (maximum > maximum_threshold || (maximum == ~(unsigned __int128)0 && big > big_threshold)) candidates.emplace_back(n, 0, big), maximum_threshold = maximum, big_threshold = big;
+            }
+
+            else if (!sweep_length(n, tables, length)) length = series_length(n);
+
+            if (statistic == Statistic::Histogram) counts.resize(std::max<size_t>(counts.size(), length + 1)), counts[length]++;
+
+            else if (statistic == Statistic::Length && length > length_threshold) candidates.emplace_back(n, length, 0), length_threshold = length;
+        }
+
+        #pragma omp ordered
+        #pragma omp critical
+        {
+            for (const auto& [n, length, maximum] : candidates) {
+
+                if (statistic == Statistic::Length  && length > record_length) record_length = length, std::cout << n << " " << length << std::endl;
+
+                if (statistic == Statistic::Maximum && maximum > record_maximum) record_maximum = maximum, std::cout << n << " " << maximum << std::endl;
+            }
+
+            histogram.resize(std::max(histogram.size(), counts.size())); for (size_t l = 0; l < counts.size(); l++) histogram[l] += counts[l];
+        }
+    }
+
+    for (size_t l = 0; l < histogram.size(); l++) if (histogram[l]) std::cout << l << " " << histogram[l] << std::endl;
+}
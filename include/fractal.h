@@ -0,0 +1,946 @@
+#pragma once
+
+#include      <mpreal.h>
+#include <multidouble.h>
+#include         <omp.h>
+#include     <algorithm>
+#include         <array>
+#include       <complex>
+#include       <fstream>
+#include    <functional>
+#include      <iostream>
+#include       <numeric>
+#include        <string>
+#include         <tuple>
+#include <unordered_map>
+#include        <vector>
+
+#include    <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include   <unistd.h>
+
+inline unsigned int nthread = 1; inline unsigned long skipped_iterations = 0, computed_pixels = 0, mismatched_pixels = 0;
+
+template <typename T>
+struct FractalFunctions {
+    std::unordered_map<std::string, std::function<std::tuple<std::complex<T>, std::complex<T>>(const std::complex<T>&, const std::complex<T>&, const std::complex<T>&, const std::complex<T>&)>> content = {
+        {"buffalo", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            std::complex<T> abs_z = {abs(z.real()), abs(z.imag())}; return std::make_tuple(abs_z * abs_z - abs_z + p, z);
+        }},
+        {"burningship", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            std::complex<T> abs_z = {abs(z.real()), abs(z.imag())}; return std::make_tuple(abs_z * abs_z + p, z);
+        }},
+        {"julia", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            return std::make_tuple(z * z + c, z);
+        }},
+        {"mandelbrot", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            return std::make_tuple(z * z + p, z);
+        }},
+        {"manowar", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            return std::make_tuple(z * z + zp + p, z);
+        }},
+        {"phoenix", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
+            return std::make_tuple(z * z - T(0.5) * zp + T(0.5667), z);
+        }}
+    };
+};
+
+template <typename T>
+struct FractalInitialConditions {
+    std::unordered_map<std::string, std::function<std::tuple<std::complex<T>, std::complex<T>, std::complex<T>>(const std::complex<T>&, const std::complex<T>&)>> content = {
+        {"buffalo",     [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
+        {"burningship", [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
+        {"julia",       [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, p, T(0));}},
+        {"mandelbrot",  [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
+        {"manowar",     [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, p, p);}},
+        {"phoenix",     [](const std::complex<T>& p, const std::complex<T>& c) {std::complex t = {-p.imag(), p.real()}; return std::make_tuple(p, t, c);}}
+    };
+};
+
+template <typename T>
+struct TrapFunctions {
+    std::vector<std::function<T(const std::complex<T>&)>> content = {
+        [](const std::complex<T>& p) {return std::norm(p);},
+        [](const std::complex<T>& p) {return std::min(abs(p.real()), abs(p.imag()));},
+        [](const std::complex<T>& p) {return std::min(abs(p.real() - p.imag()), abs(p.real() + p.imag())) / sqrt(2);},
+        [](const std::complex<T>& p) {return abs(std::norm(p) - 1.0);},
+        [](const std::complex<T>& p) {return std::min(std::norm(p), abs(std::norm(p) - 1.0));}
+    }; 
+};
+
+enum class FractalType {
+    Buffalo, Burningship, Julia, Mandelbrot, Manowar, Phoenix
+};
+
+#if defined(__AVX512F__)
+constexpr int simd_width = 8;
+#else
+constexpr int simd_width = 4;
+#endif
+
+inline FractalType fractal_type(const std::string& name) {
+    static const std::unordered_map<std::string, FractalType> types = {
+        {"buffalo", FractalType::Buffalo}, {"burningship", FractalType::Burningship}, {"julia", FractalType::Julia}, {"mandelbrot", FractalType::Mandelbrot}, {"manowar", FractalType::Manowar}, {"phoenix", FractalType::Phoenix}
+    }; return types.at(name);
+}
+
+template <FractalType F>
+inline void fractal_initial_lane(double pr, double pi, double& zr, double& zi, double& zpr, double& zpi, double cr, double ci) {
+    if constexpr (F == FractalType::Buffalo    ) zr =   0, zi =  0, zpr =  0, zpi =  0;
+    if constexpr (F == FractalType::Burningship) zr =   0, zi =  0, zpr =  0, zpi =  0;
+    if constexpr (F == FractalType::Julia      ) zr =  pr, zi = pi, zpr =  0, zpi =  0;
+    if constexpr (F == FractalType::Mandelbrot ) zr =   0, zi =  0, zpr =  0, zpi =  0;
+    if constexpr (F == FractalType::Manowar    ) zr =  pr, zi = pi, zpr = pr, zpi = pi;
+    if constexpr (F == FractalType::Phoenix    ) zr = -pi, zi = pr, zpr = cr, zpi = ci;
+}
+
+template <FractalType F>
+inline void fractal_step_lane(double pr, double pi, double& zr, double& zi, double& zpr, double& zpi, double cr, double ci) {
+    double xr, xi, ar = abs(zr), ai = abs(zi);
+
+    if constexpr (F == FractalType::Buffalo    ) xr = ar * ar - ai * ai - ar + pr,         xi = ar * ai + ai * ar - ai + pi;
+    if constexpr (F == FractalType::Burningship) xr = ar * ar - ai * ai + pr,              xi = ar * ai + ai * ar + pi;
+    if constexpr (F == FractalType::Julia      ) xr = zr * zr - zi * zi + cr,              xi = zr * zi + zi * zr + ci;
+    if constexpr (F == FractalType::Mandelbrot ) xr = zr * zr - zi * zi + pr,              xi = zr * zi + zi * zr + pi;
+    if constexpr (F == FractalType::Manowar    ) xr = zr * zr - zi * zi + zpr + pr,        xi = zr * zi + zi * zr + zpi + pi;
+    if constexpr (F == FractalType::Phoenix    ) xr = zr * zr - zi * zi - 0.5 * zpr + 0.5667, xi = zr * zi + zi * zr - 0.5 * zpi;
+
+    zpr = zr, zpi = zi, zr = xr, zi = xi;
+}
+
+template <typename T>
+inline bool mandelbrot_bulb(const T& re, const T& im) {
+    T q = (re - 0.25) * (re - 0.25) + im * im; return q * (q + (re - 0.25)) < 0.25 * im * im || (re + 1) * (re + 1) + im * im < 0.0625;
+}
+
+template <typename T>
+T periodicity_tolerance() {
+    T tolerance = 1024 * std::numeric_limits<T>::epsilon(); return tolerance * tolerance;
+}
+
+inline uint64_t splitmix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL, x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL; return x ^ (x >> 31);
+}
+
+inline double counter_uniform(uint64_t seed, uint64_t counter) {
+    return (splitmix(splitmix(seed + 0x9E3779B97F4A7C15ULL) + (counter + 1) * 0x9E3779B97F4A7C15ULL) >> 11) * 0x1.0p-53;
+}
+
+struct Image {
+    std::vector<unsigned char> data; unsigned int width, height, top, frame_height;
+};
+
+enum class FieldType {Density, Escape, Trap};
+
+struct Field {
+    std::vector<double> data; unsigned int width, height; FieldType type; double scale;
+};
+
+struct Fractal {
+    std::string name; double parameter;
+};
+
+struct Density {
+    double bailout_radius, mutation; unsigned int max_iterations, seed, chains, warmup; unsigned long samples; bool enable_smooth, enable_metropolis;
+};
+
+struct Escape {
+    double bailout_radius; unsigned int max_iterations, subdivision_size; bool enable_smooth, enable_interior, enable_subdivision, verify_subdivision;
+};
+
+typedef std::function<unsigned long(const size_t*, int, unsigned int*, double*)> EscapeEvaluator;
+
+struct Tile {
+    unsigned int top, left, height, width, thread; double time; unsigned long iterations, escaped, interior;
+};
+
+inline std::vector<Tile> tile_statistics; inline std::vector<double> thread_busy; inline double tile_wall = 0;
+
+struct Perturbation {
+    bool enable_series;
+};
+
+struct Trap {
+    double bailout_radius; unsigned int max_iterations, trap_index; bool fill_background, enable_interior;
+};
+
+struct Linear {
+    std::array<unsigned char, 3> from, to;
+};
+
+struct Periodic {
+    std::array<double, 3> amplitude; std::array<double, 3> phase;
+};
+
+struct Solid {
+    std::array<unsigned char, 3> color;
+};
+
+template <class F>
+void draw_tiles(const Image& image, const F& function) {
+    unsigned int side = std::clamp((unsigned int)sqrt((double)image.width * image.height / (64 * nthread)), 16U, 256U); std::vector<Tile> tiles; double start = omp_get_wtime();
+
+    for (unsigned int i = 0; i < image.height; i += side) for (unsigned int j = 0; j < image.width; j += side) tiles.push_back({i, j, std::min(side, image.height - i), std::min(side, image.width - j), 0, 0, 0, 0, 0});
+
+    thread_busy.resize(std::max<size_t>(thread_busy.size(), nthread), 0);
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(nthread)
+    for (size_t k = 0; k < tiles.size(); k++) {
+        double begin = omp_get_wtime(); function(tiles[k]); tiles[k].time = omp_get_wtime() - begin, tiles[k].thread = omp_get_thread_num(), thread_busy[tiles[k].thread] += tiles[k].time;
+    }
+
+    tile_wall += omp_get_wtime() - start; for (Tile& tile : tiles) tile.top += image.top, tile_statistics.push_back(tile);
+}
+
+inline void write_report(const std::string& filename) {
+    std::ofstream file(filename); unsigned long iterations = 0, escaped = 0, interior = 0; for (const Tile& tile : tile_statistics) iterations += tile.iterations, escaped += tile.escaped, interior += tile.interior;
+
+    file << "{\"threads\": " << nthread << ", \"wall\": " << tile_wall << ", \"iterations\": " << iterations << ", \"iterations_per_second\": " << (tile_wall > 0 ? iterations / tile_wall : 0) << ", \"escaped\": " << escaped << ", \"interior\": " << interior << ",\n";
+
+    file << " \"busy\": ["; for (size_t k = 0; k < thread_busy.size(); k++) file << (k ? ", " : "") << thread_busy.at(k); file << "],\n";
+    file << " \"idle\": ["; for (size_t k = 0; k < thread_busy.size(); k++) file << (k ? ", " : "") << tile_wall - thread_busy.at(k); file << "],\n";
+
+    file << " \"tiles\": [\n"; for (size_t k = 0; k < tile_statistics.size(); k++) {
+        const Tile& tile = tile_statistics.at(k); file << "  {\"top\": " << tile.top << ", \"left\": " << tile.left << ", \"height\": " << tile.height << ", \"width\": " << tile.width << ", \"thread\": " << tile.thread << ", \"time\": " << tile.time;
+        file << ", \"iterations\": " << tile.iterations << ", \"escaped\": " << tile.escaped << ", \"interior\": " << tile.interior << "}" << (k + 1 < tile_statistics.size() ? ",\n" : "\n");
+    } file << " ]\n}\n";
+
+    if (!file) throw std::runtime_error("COULD NOT WRITE THE REPORT FILE");
+}
+
+template <typename T>
+T multidouble_cast(const mpfr::mpreal& value) {
+    T result = 0; mpfr::mpreal rest = value;
+
+    for (int k = 0; k < T::terms; k++) result += rest.toDouble(), rest -= rest.toDouble();
+
+    return result;
+}
+
+template <typename T>
+int density_index(const Image& image, const std::complex<T>& o, const std::complex<T>& center, const T& zoom) {
+    int i = (int)round(((o.imag() + center.imag()) * image.height * zoom + 1.5 * image.height) / 3.0 - 0.5);
+    int j = (int)round(((o.real() - center.real()) * image.height * zoom + 1.5 * image.width)  / 3.0 - 0.5);
+
+    return i < 0 || j < 0 || i >= (int)image.height || j >= (int)image.width ? -1 : i * image.width + j;
+}
+
+template <typename T>
+std::vector<double> density_uniform(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Density& density_algorithm) {
+    auto fractal_function = FractalFunctions<T>().content.at(fractal.name); auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name);
+
+    std::vector<double> data(image.width * image.height, 0); std::vector<std::vector<unsigned int>> thread_data(nthread, std::vector<unsigned int>(data.size(), 0));
+
+    std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter));
+
+    #pragma omp parallel num_threads(nthread)
+    {
+        std::vector<unsigned int>& histogram = thread_data.at(omp_get_thread_num()); std::vector<std::complex<T>> orbit; orbit.reserve(density_algorithm.max_iterations);
+
+        #pragma omp for schedule(dynamic, 4096)
+        for (unsigned long k = 0; k < density_algorithm.samples; k++) {
+
+            std::complex<T> p = std::complex<double>(-3.9 + 7.8 * counter_uniform(density_algorithm.seed, 2 * k), -2.5 + 5.0 * counter_uniform(density_algorithm.seed, 2 * k + 1)), z, zp;
+
+            std::tie(std::ignore, z, zp) = fractal_ic_function(p, parameter); orbit.clear();
+
+            for (unsigned int n = 0; n < density_algorithm.max_iterations; n++) {
+                std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > density_algorithm.bailout_radius * density_algorithm.bailout_radius) break; orbit.push_back(z);
+            }
+
+            if (std::norm(z) > density_algorithm.bailout_radius * density_algorithm.bailout_radius) for (const std::complex<T>& o : orbit) {
+                if (int index = density_index(image, o, center, zoom); index >= 0) histogram[index]++;
+            }
+        }
+    }
+
+    #pragma omp parallel for num_threads(nthread)
+    for (size_t j = 0; j < data.size(); j++) for (unsigned int i = 0; i < nthread; i++) data[j] += thread_data[i][j];
+
+    return data;
+}
+
+template <typename T>
+std::vector<double> density_metropolis(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Density& density_algorithm) {
+    auto fractal_function = FractalFunctions<T>().content.at(fractal.name); auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name);
+
+    std::vector<double> data(image.width * image.height, 0); std::vector<std::vector<uint64_t>> thread_data(nthread, std::vector<uint64_t>(data.size(), 0));
+
+    std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter)); T radius = T(3 * density_algorithm.mutation) / zoom;
+
+    #pragma omp parallel num_threads(nthread)
+    {
+        std::vector<uint64_t>& histogram = thread_data.at(omp_get_thread_num()); std::vector<int> current, proposal;
+
+        auto contribution = [&](const std::complex<T>& p, std::vector<int>& hits) {
+            std::complex<T> z, zp; std::tie(std::ignore, z, zp) = fractal_ic_function(p, parameter); hits.clear();
+
+            if (abs(p.real()) > 3.9 || abs(p.imag()) > 2.5) return;
+
+            for (unsigned int n = 0; n < density_algorithm.max_iterations; n++) {
+                std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > density_algorithm.bailout_radius * density_algorithm.bailout_radius) return;
+                if (int index = density_index(image, z, center, zoom); index >= 0) hits.push_back(index);
+            }
+
+            hits.clear();
+        };
+
+        #pragma omp for schedule(dynamic, 1)
+        for (unsigned int chain = 0; chain < density_algorithm.chains; chain++) {
+
+            uint64_t stream = splitmix(density_algorithm.seed ^ splitmix(chain + 1)), counter = 0; unsigned long steps = density_algorithm.samples / density_algorithm.chains;
+
+            auto random  = [&]() {return counter_uniform(stream, counter++);};
+            auto uniform = [&]() {double re = -3.9 + 7.8 * random(), im = -2.5 + 5.0 * random(); return std::complex<T>(std::complex<double>(re, im));};
+
+            std::complex<T> p; current.clear();
+
+            for (unsigned long k = 0; k < steps && current.empty(); k++) contribution(p = uniform(), current);
+
+            for (unsigned long k = 0; !current.empty() && k < density_algorithm.warmup + steps; k++) {
+
+                std::complex<T> q; if (random() < 0.25) q = uniform(); else {
+                    double re = 2 * random() - 1, im = 2 * random() - 1; q = p + std::complex<T>(radius * re, radius * im);
+                }
+
+                if (contribution(q, proposal); random() * current.size() < proposal.size()) p = q, std::swap(current, proposal);
+
+                if (k >= density_algorithm.warmup) for (int index : current) histogram[index] += (1ULL << 32) / current.size();
+            }
+        }
+    }
+
+    #pragma omp parallel for num_threads(nthread)
+    for (size_t j = 0; j < data.size(); j++) for (unsigned int i = 0; i < nthread; i++) data[j] += thread_data[i][j];
+
+    return data;
+}
+
+template <typename T>
+Field density_field(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Density& density_algorithm) {
+    std::vector<double> data = density_algorithm.enable_metropolis ? density_metropolis(image, fractal, center, zoom, density_algorithm) : density_uniform(image, fractal, center, zoom, density_algorithm);
+
+    double max = *std::max_element(data.begin(), data.end()); return {data, image.width, image.height, FieldType::Density, max};
+}
+
+template <FractalType F>
+unsigned long escape_lanes(const double* pr, const double* pi, int lanes, const std::complex<double>& c, const Escape& escape_algorithm, unsigned int* n, double* norm) {
+    alignas(64) double zr[simd_width], zi[simd_width], zpr[simd_width], zpi[simd_width], sr[simd_width], si[simd_width], spr[simd_width], spi[simd_width]; alignas(64) int active[simd_width];
+
+    double bailout_norm = escape_algorithm.bailout_radius * escape_algorithm.bailout_radius, tolerance = periodicity_tolerance<double>(); unsigned long skipped = 0;
+
+    for (int l = 0; l < simd_width; l++) {
+        fractal_initial_lane<F>(pr[l], pi[l], zr[l], zi[l], zpr[l], zpi[l], c.real(), c.imag()); n[l] = escape_algorithm.max_iterations, active[l] = l < lanes;
+    }
+
+    if constexpr (F == FractalType::Mandelbrot) if (escape_algorithm.enable_interior) for (int l = 0; l < simd_width; l++) {
+        if (active[l] && mandelbrot_bulb(pr[l], pi[l])) active[l] = 0, skipped += escape_algorithm.max_iterations;
+    }
+
+    std::copy(zr, zr + simd_width, sr), std::copy(zi, zi + simd_width, si), std::copy(zpr, zpr + simd_width, spr), std::copy(zpi, zpi + simd_width, spi);
+
+    for (unsigned int k = 0, check = 1, running = std::accumulate(active, active + simd_width, 0); k < escape_algorithm.max_iterations && running; k++) {
+
+        running = 0;
+
+        #pragma omp simd reduction(+:running, skipped)
+        for (int l = 0; l < simd_width; l++) {
+
+            double xr = zr[l], xi = zi[l], xpr = zpr[l], xpi = zpi[l]; fractal_step_lane<F>(pr[l], pi[l], xr, xi, xpr, xpi, c.real(), c.imag());
+
+            bool escaped = xr * xr + xi * xi > bailout_norm, periodic = escape_algorithm.enable_interior && (xr - sr[l]) * (xr - sr[l]) + (xi - si[l]) * (xi - si[l]) + (xpr - spr[l]) * (xpr - spr[l]) + (xpi - spi[l]) * (xpi - spi[l]) < tolerance;
+
+            zr[l] = active[l] ? xr : zr[l], zi[l] = active[l] ? xi : zi[l], zpr[l] = active[l] ? xpr : zpr[l], zpi[l] = active[l] ? xpi : zpi[l];
+
+            n[l] = active[l] && escaped ? k : n[l]; skipped += active[l] && !escaped && periodic ? escape_algorithm.max_iterations - k - 1 : 0;
+
+            active[l] = active[l] && !escaped && !periodic; running += active[l];
+        }
+
+        if (escape_algorithm.enable_interior && k + 1 == check) {
+            std::copy(zr, zr + simd_width, sr), std::copy(zi, zi + simd_width, si), std::copy(zpr, zpr + simd_width, spr), std::copy(zpi, zpi + simd_width, spi), check *= 2;
+        }
+    }
+
+    for (int l = 0; l < simd_width; l++) norm[l] = zr[l] * zr[l] + zi[l] * zi[l];
+
+    return skipped;
+}
+
+template <FractalType F>
+unsigned long escape_pixels(const Image& image, const std::complex<double>& center, double zoom, const std::complex<double>& parameter, const Escape& escape_algorithm, const size_t* index, int count, unsigned int* n, double* v) {
+    unsigned long skipped = 0;
+
+    for (int k = 0; k < count; k += simd_width) {
+
+        alignas(64) double re[simd_width], im[simd_width], norm[simd_width]; alignas(64) unsigned int m[simd_width]; int lanes = std::min(simd_width, count - k);
+
+        for (int l = 0; l < simd_width; l++) {
+
+            size_t i = index[k + std::min(l, lanes - 1)] / image.width, j = index[k + std::min(l, lanes - 1)] % image.width;
+
+            im[l] = -center.imag() + (3.0 * (image.top + i + 0.5) - 1.5 * image.frame_height) / zoom / image.frame_height;
+            re[l] =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.frame_height;
+        }
+
+        skipped += escape_lanes<F>(re, im, lanes, parameter, escape_algorithm, m, norm);
+
+        for (int l = 0; l < lanes; l++) {
+            n[k + l] = m[l], v[k + l] = m[l]; if (m[l] < escape_algorithm.max_iterations && escape_algorithm.enable_smooth) v[k + l] -= log2(0.5 * log(norm[l]));
+        }
+    }
+
+    return skipped;
+}
+
+template <typename T>
+EscapeEvaluator escape_evaluator(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Escape& escape_algorithm) {
+    if constexpr (std::is_same<T, double>()) {
+
+        std::complex<double> parameter = exp(std::complex<double>{0, 1} * double(fractal.parameter));
+
+        switch (fractal_type(fractal.name)) {
+            case FractalType::Buffalo:     return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Buffalo    >(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+            case FractalType::Burningship: return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Burningship>(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+            case FractalType::Julia:       return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Julia      >(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+            case FractalType::Mandelbrot:  return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Mandelbrot >(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+            case FractalType::Manowar:     return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Manowar    >(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+            case FractalType::Phoenix:     return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {return escape_pixels<FractalType::Phoenix    >(image, center, zoom, parameter, escape_algorithm, index, count, n, v);};
+        }
+    }
+
+    auto fractal_function = FractalFunctions<T>().content.at(fractal.name); auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name); bool mandelbrot = fractal.name == "mandelbrot";
+
+    std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter));
+
+    return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {
+        T tolerance = periodicity_tolerance<T>(); unsigned long skipped = 0;
+
+        for (int k = 0; k < count; k++) {
+
+            size_t i = index[k] / image.width, j = index[k] % image.width;
+
+            T im = -center.imag() + (3.0 * (image.top + i + 0.5) - 1.5 * image.frame_height) / zoom / image.frame_height;
+            T re =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.frame_height;
+
+            auto [p, z, zp] = fractal_ic_function(std::complex<T>{re, im}, parameter); std::complex<T> z_saved = z, zp_saved = zp; unsigned int m = 0; T u;
+
+            if (escape_algorithm.enable_interior && mandelbrot && mandelbrot_bulb(re, im)) m = escape_algorithm.max_iterations, skipped += escape_algorithm.max_iterations;
+
+            for (unsigned int check = 1; m < escape_algorithm.max_iterations; m++) {
+                std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > escape_algorithm.bailout_radius * escape_algorithm.bailout_radius) break;
+
+                if (escape_algorithm.enable_interior && std::norm(z - z_saved) + std::norm(zp - zp_saved) < tolerance) {
+                    skipped += escape_algorithm.max_iterations - m - 1, m = escape_algorithm.max_iterations; break;
+                }
+
+                if (escape_algorithm.enable_interior && m + 1 == check) z_saved = z, zp_saved = zp, check *= 2;
+            }
+
+            if (u = m; m < escape_algorithm.max_iterations && escape_algorithm.enable_smooth) u -= log2(0.5 * log(std::norm(z)));
+
+            n[k] = m, v[k] = double(u);
+        }
+
+        return skipped;
+    };
+}
+
+inline double diffabs(double c, double d) {
+    return c >= 0 ? (c + d >= 0 ? d : -(2 * c + d)) : (c + d > 0 ? 2 * c + d : -d);
+}
+
+template <FractalType F>
+inline void perturbation_step(const std::complex<double>& reference, double& zr, double& zi, double dcr, double dci) {
+    double xr = reference.real(), xi = reference.imag(), yr, yi;
+
+    if constexpr (F == FractalType::Buffalo    ) yr = (2 * xr + zr) * zr - (2 * xi + zi) * zi - diffabs(xr, zr) + dcr, yi = 2 * diffabs(xr * xi, xr * zi + zr * xi + zr * zi) - diffabs(xi, zi) + dci;
+    if constexpr (F == FractalType::Burningship) yr = (2 * xr + zr) * zr - (2 * xi + zi) * zi + dcr,                   yi = 2 * diffabs(xr * xi, xr * zi + zr * xi + zr * zi) + dci;
+    if constexpr (F == FractalType::Mandelbrot ) yr = (2 * xr + zr) * zr - (2 * xi + zi) * zi + dcr,                   yi = (2 * xr + zr) * zi + (2 * xi + zi) * zr + dci;
+
+    zr = yr, zi = yi;
+}
+
+template <FractalType F>
+std::vector<std::complex<double>> reference_orbit(const std::complex<mpfr::mpreal>& reference, const Escape& escape_algorithm) {
+    std::vector<std::complex<double>> orbit = {{0, 0}}; mpfr::mpreal zr = 0, zi = 0, xr, xi, bailout_norm = escape_algorithm.bailout_radius * escape_algorithm.bailout_radius;
+
+    for (unsigned int n = 0; n < escape_algorithm.max_iterations; n++) {
+
+        if constexpr (F == FractalType::Buffalo    ) xr = zr * zr - zi * zi - abs(zr) + reference.real(), xi = 2 * abs(zr * zi) - abs(zi) + reference.imag();
+        if constexpr (F == FractalType::Burningship) xr = zr * zr - zi * zi + reference.real(),           xi = 2 * abs(zr * zi) + reference.imag();
+        if constexpr (F == FractalType::Mandelbrot ) xr = zr * zr - zi * zi + reference.real(),           xi = 2 * zr * zi + reference.imag();
+
+        zr = xr, zi = xi; orbit.push_back({zr.toDouble(), zi.toDouble()}); if (zr * zr + zi * zi > bailout_norm) break;
+    }
+
+    return orbit;
+}
+
+template <FractalType F>
+const std::vector<std::complex<double>>& cached_reference_orbit(const std::complex<mpfr::mpreal>& reference, const Escape& escape_algorithm) {
+    static std::string key; static std::vector<std::complex<double>> orbit;
+
+    std::string current = reference.real().toString() + " " + reference.imag().toString() + " " + std::to_string(reference.real().get_prec()) + " " + std::to_string(escape_algorithm.max_iterations) + " " + std::to_string(escape_algorithm.bailout_radius);
+
+    if (current != key) orbit = reference_orbit<F>(reference, escape_algorithm), key = current;
+
+    return orbit;
+}
+
+inline unsigned int series_skip(const std::vector<std::complex<double>>& orbit, double delta, std::array<std::vector<std::complex<double>>, 3>& coefficients) {
+    coefficients = {std::vector<std::complex<double>>{0}, std::vector<std::complex<double>>{0}, std::vector<std::complex<double>>{0}}; unsigned int skip = 0;
+
+    for (size_t n = 0; n + 2 < orbit.size(); n++) {
+
+        std::complex<double> A = coefficients.at(0).back(), B = coefficients.at(1).back(), C = coefficients.at(2).back();
+
+        A = 2.0 * orbit.at(n) * A + 1.0, C = 2.0 * orbit.at(n) * C + 2.0 * coefficients.at(0).back() * B, B = 2.0 * orbit.at(n) * B + coefficients.at(0).back() * coefficients.at(0).back();
+
+        if (!std::isfinite(std::norm(C)) || std::abs(C) * delta * delta > 1e-9 * std::abs(A)) break;
+
+        coefficients.at(0).push_back(A), coefficients.at(1).push_back(B), coefficients.at(2).push_back(C), skip = n + 1;
+    }
+
+    return skip;
+}
+
+template <FractalType F>
+EscapeEvaluator perturbation_evaluator(const Image& image, const std::complex<mpfr::mpreal>& center, const mpfr::mpreal& zoom, const Escape& escape_algorithm, const Perturbation& perturbation_algorithm) {
+    std::vector<std::complex<double>> orbit = cached_reference_orbit<F>({center.real(), -center.imag()}, escape_algorithm); std::array<std::vector<std::complex<double>>, 3> coefficients;
+
+    double step = mpfr::mpreal(1 / (zoom * image.frame_height)).toDouble(), bailout_norm = escape_algorithm.bailout_radius * escape_algorithm.bailout_radius; unsigned int skip = 0;
+
+    if (step < 1e-290) throw std::runtime_error("ZOOM IS TOO DEEP FOR THE DOUBLE PRECISION PERTURBATION");
+
+    auto iterate = [orbit, bailout_norm](double dcr, double dci, unsigned int n, unsigned int m, double zr, double zi, unsigned int limit, bool rebase) {
+        for (; n < limit; n++) {
+
+            perturbation_step<F>(orbit[m++], zr, zi, dcr, dci); double xr = orbit[m].real() + zr, xi = orbit[m].imag() + zi;
+
+            if (xr * xr + xi * xi > bailout_norm) return std::make_tuple(n, xr * xr + xi * xi, zr, zi);
+
+            if (rebase && (xr * xr + xi * xi < zr * zr + zi * zi || m == orbit.size() - 1)) zr = xr, zi = xi, m = 0;
+        }
+
+        return std::make_tuple(n, orbit[m].real() * orbit[m].real() + orbit[m].imag() * orbit[m].imag(), zr, zi);
+    };
+
+    auto series = [&coefficients](double dcr, double dci, unsigned int n) {
+        std::complex<double> dc = {dcr, dci}; return coefficients.at(0).at(n) * dc + coefficients.at(1).at(n) * dc * dc + coefficients.at(2).at(n) * dc * dc * dc;
+    };
+
+    if constexpr (F == FractalType::Mandelbrot) if (perturbation_algorithm.enable_series) {
+
+        skip = series_skip(orbit, 1.5 * std::hypot((double)image.width, (double)image.frame_height) * step, coefficients);
+
+        for (bool valid = false; skip && !valid; skip = valid ? skip : skip / 2) {
+
+            valid = true;
+
+            for (double dcr : {-1.5 * image.width * step, 1.5 * image.width * step}) for (double dci : {-1.5 * image.frame_height * step, 1.5 * image.frame_height * step}) {
+
+                auto [n, norm, zr, zi] = iterate(dcr, dci, 0, 0, 0, 0, skip, false); std::complex<double> z = series(dcr, dci, skip);
+
+                valid &= n == skip && std::abs(z - std::complex<double>{zr, zi}) <= 1e-3 * std::abs(std::complex<double>{zr, zi});
+            }
+        }
+    }
+
+    std::array<std::complex<double>, 3> terms = {}; if (skip) terms = {coefficients.at(0).at(skip), coefficients.at(1).at(skip), coefficients.at(2).at(skip)};
+
+    return [=, &image](const size_t* index, int count, unsigned int* n, double* v) {
+        for (int k = 0; k < count; k++) {
+
+            double dci = (3.0 * (image.top + index[k] / image.width + 0.5) - 1.5 * image.frame_height) * step;
+            double dcr = (3.0 * (index[k] % image.width + 0.5) - 1.5 * image.width)  * step;
+
+            std::complex<double> dc = {dcr, dci}, z = skip ? terms.at(0) * dc + terms.at(1) * dc * dc + terms.at(2) * dc * dc * dc : std::complex<double>{0, 0};
+
+            auto [m, norm, zr, zi] = iterate(dcr, dci, skip, skip, z.real(), z.imag(), escape_algorithm.max_iterations, true);
+
+            n[k] = m, v[k] = m; if (m < escape_algorithm.max_iterations && escape_algorithm.enable_smooth) v[k] -= log2(0.5 * log(norm));
+        }
+
+        return 0UL;
+    };
+}
+
+inline void count_iterations(Tile& tile, const unsigned int* n, size_t count, unsigned long skipped, unsigned int max_iterations) {
+    for (size_t k = 0; k < count; k++) tile.iterations += std::min(n[k] + 1, max_iterations), tile.escaped += n[k] < max_iterations, tile.interior += n[k] >= max_iterations;
+
+    tile.iterations -= skipped;
+}
+
+inline void subdivide(const Image& image, const EscapeEvaluator& evaluate, const Escape& escape_algorithm, std::vector<unsigned int>& n, std::vector<double>& v, std::vector<unsigned char>& computed, std::vector<Tile>& shares, unsigned int i0, unsigned int j0, unsigned int i1, unsigned int j1) {
+    auto compute = [&](std::vector<size_t>& index) {
+        std::vector<unsigned int> m(index.size()); std::vector<double> u(index.size()); Tile& share = shares.at(omp_get_thread_num()); double begin = omp_get_wtime();
+
+        unsigned long skipped = evaluate(index.data(), index.size(), m.data(), u.data()); share.time += omp_get_wtime() - begin; count_iterations(share, m.data(), m.size(), skipped, escape_algorithm.max_iterations);
+
+        for (size_t k = 0; k < index.size(); k++) n[index[k]] = m[k], v[index[k]] = u[k], computed[index[k]] = 1;
+
+        #pragma omp atomic
+        computed_pixels += index.size();
+
+        if (escape_algorithm.enable_interior) {
+            #pragma omp atomic
+            skipped_iterations += skipped;
+        }
+    };
+
+    if (i1 - i0 < 2 || j1 - j0 < 2) return;
+
+    bool uniform = escape_algorithm.enable_smooth ? n[i0 * image.width + j0] == escape_algorithm.max_iterations : true;
+
+    for (unsigned int i = i0; i <= i1; i++) uniform &= n[i * image.width + j0] == n[i0 * image.width + j0] && n[i * image.width + j1] == n[i0 * image.width + j0];
+    for (unsigned int j = j0; j <= j1; j++) uniform &= n[i0 * image.width + j] == n[i0 * image.width + j0] && n[i1 * image.width + j] == n[i0 * image.width + j0];
+
+    if (uniform) {
+        for (unsigned int i = i0 + 1; i < i1; i++) for (unsigned int j = j0 + 1; j < j1; j++) n[i * image.width + j] = n[i0 * image.width + j0], v[i * image.width + j] = n[i0 * image.width + j0];
+    } else if (i1 - i0 <= escape_algorithm.subdivision_size || j1 - j0 <= escape_algorithm.subdivision_size) {
+        std::vector<size_t> index; for (unsigned int i = i0 + 1; i < i1; i++) for (unsigned int j = j0 + 1; j < j1; j++) index.push_back(i * image.width + j); compute(index);
+    } else {
+        unsigned int im = (i0 + i1) / 2, jm = (j0 + j1) / 2; std::vector<size_t> index;
+
+        for (unsigned int j = j0 + 1; j < j1; j++) index.push_back(im * image.width + j);
+        for (unsigned int i = i0 + 1; i < i1; i++) if (i != im) index.push_back(i * image.width + jm);
+
+        compute(index); bool task = (i1 - i0) * (j1 - j0) > 4096;
+
+        #pragma omp task if(task) shared(image, evaluate, escape_algorithm, n, v, computed, shares)
+        subdivide(image, evaluate, escape_algorithm, n, v, computed, shares, i0, j0, im, jm);
+        #pragma omp task if(task) shared(image, evaluate, escape_algorithm, n, v, computed, shares)
+        subdivide(image, evaluate, escape_algorithm, n, v, computed, shares, i0, jm, im, j1);
+        #pragma omp task if(task) shared(image, evaluate, escape_algorithm, n, v, computed, shares)
+        subdivide(image, evaluate, escape_algorithm, n, v, computed, shares, im, j0, i1, jm);
+        #pragma omp task if(task) shared(image, evaluate, escape_algorithm, n, v, computed, shares)
+        subdivide(image, evaluate, escape_algorithm, n, v, computed, shares, im, jm, i1, j1);
+    }
+}
+
+inline Field evaluator_field(const Image& image, const EscapeEvaluator& evaluate, const Escape& escape_algorithm) {
+    std::vector<unsigned int> n(image.width * image.height); std::vector<double> v(image.width * image.height);
+
+    if (escape_algorithm.enable_subdivision) {
+
+        std::vector<size_t> index; std::vector<unsigned char> computed(n.size(), 0); std::vector<Tile> shares(nthread); double start = omp_get_wtime();
+
+        for (unsigned int t = 0; t < nthread; t++) shares.at(t) = {image.top, 0, image.height, image.width, t, 0, 0, 0, 0};
+
+        for (unsigned int j = 0; j < image.width; j++) {
+            index.push_back(j); if (image.height > 1) index.push_back((image.height - 1) * image.width + j);
+        }
+
+        for (unsigned int i = 1; i + 1 < image.height; i++) {
+            index.push_back(i * image.width); if (image.width > 1) index.push_back(i * image.width + image.width - 1);
+        }
+
+        #pragma omp parallel for num_threads(nthread) reduction(+:skipped_iterations)
+        for (size_t k = 0; k < index.size(); k += 64) {
+            std::vector<unsigned int> m(std::min<size_t>(64, index.size() - k)); std::vector<double> u(m.size()); Tile& share = shares.at(omp_get_thread_num()); double begin = omp_get_wtime();
+
+            unsigned long skipped = evaluate(index.data() + k, m.size(), m.data(), u.data()); share.time += omp_get_wtime() - begin, skipped_iterations += skipped; count_iterations(share, m.data(), m.size(), skipped, escape_algorithm.max_iterations);
+            for (size_t l = 0; l < m.size(); l++) n[index[k + l]] = m[l], v[index[k + l]] = u[l], computed[index[k + l]] = 1;
+        }
+
+        computed_pixels += index.size();
+
+        #pragma omp parallel num_threads(nthread)
+        #pragma omp single
+        subdivide(image, evaluate, escape_algorithm, n, v, computed, shares, 0, 0, image.height - 1, image.width - 1);
+
+        thread_busy.resize(std::max<size_t>(thread_busy.size(), nthread), 0), tile_wall += omp_get_wtime() - start;
+
+        for (const Tile& share : shares) if (share.escaped + share.interior) thread_busy.at(share.thread) += share.time, tile_statistics.push_back(share);
+
+        if (escape_algorithm.verify_subdivision) {
+
+            #pragma omp parallel for num_threads(nthread) reduction(+:mismatched_pixels)
+            for (unsigned int i = 0; i < image.height; i++) {
+
+                std::vector<size_t> index; std::vector<unsigned int> m; std::vector<double> u;
+
+                for (unsigned int j = 0; j < image.width; j++) if (!computed[i * image.width + j]) index.push_back(i * image.width + j);
+
+                m.resize(index.size()), u.resize(index.size()); evaluate(index.data(), index.size(), m.data(), u.data());
+
+                for (size_t k = 0; k < index.size(); k++) mismatched_pixels += n[index[k]] != m[k] || v[index[k]] != u[k], n[index[k]] = m[k], v[index[k]] = u[k];
+            }
+        }
+    } else {
+
+        draw_tiles(image, [&](Tile& tile) {
+            std::vector<size_t> index(tile.width); unsigned long skipped = 0;
+
+            for (unsigned int i = tile.top; i < tile.top + tile.height; i++) {
+
+                std::iota(index.begin(), index.end(), (size_t)i * image.width + tile.left); skipped += evaluate(index.data(), tile.width, n.data() + i * image.width + tile.left, v.data() + i * image.width + tile.left);
+
+                count_iterations(tile, n.data() + i * image.width + tile.left, tile.width, 0, escape_algorithm.max_iterations);
+            }
+
+            tile.iterations -= skipped;
+
+            if (escape_algorithm.enable_interior) {
+                #pragma omp atomic
+                skipped_iterations += skipped;
+            }
+        });
+
+        computed_pixels += n.size();
+    }
+
+    #pragma omp parallel for num_threads(nthread)
+    for (size_t k = 0; k < n.size(); k++) if (n[k] >= escape_algorithm.max_iterations) v[k] = std::numeric_limits<double>::quiet_NaN();
+
+    return {v, image.width, image.height, FieldType::Escape, (double)escape_algorithm.max_iterations};
+}
+
+template <typename T>
+Field escape_field(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Escape& escape_algorithm) {
+    return evaluator_field(image, escape_evaluator(image, fractal, center, zoom, escape_algorithm), escape_algorithm);
+}
+
+inline Field perturbation_field(const Image& image, const Fractal& fractal, const std::complex<mpfr::mpreal>& center, const mpfr::mpreal& zoom, const Escape& escape_algorithm, const Perturbation& perturbation_algorithm) {
+    switch (fractal_type(fractal.name)) {
+        case FractalType::Buffalo:     return evaluator_field(image, perturbation_evaluator<FractalType::Buffalo    >(image, center, zoom, escape_algorithm, perturbation_algorithm), escape_algorithm);
+        case FractalType::Burningship: return evaluator_field(image, perturbation_evaluator<FractalType::Burningship>(image, center, zoom, escape_algorithm, perturbation_algorithm), escape_algorithm);
+        case FractalType::Mandelbrot:  return evaluator_field(image, perturbation_evaluator<FractalType::Mandelbrot >(image, center, zoom, escape_algorithm, perturbation_algorithm), escape_algorithm);
+        default: throw std::runtime_error("PERTURBATION IS NOT SUPPORTED FOR THIS FRACTAL");
+    }
+}
+
+template <FractalType F>
+Field trap_kernel(const Image& image, const std::complex<double>& center, double zoom, const std::complex<double>& c, const Trap& trap_algorithm) {
+    auto trap_function = TrapFunctions<double>().content.at(trap_algorithm.trap_index); double tolerance = periodicity_tolerance<double>(), bailout_norm = trap_algorithm.bailout_radius * trap_algorithm.bailout_radius;
+
+    Field field = {std::vector<double>(image.width * image.height, std::numeric_limits<double>::quiet_NaN()), image.width, image.height, FieldType::Trap, 1};
+
+    draw_tiles(image, [&](Tile& tile) {
+        unsigned long skipped = 0;
+
+        for (unsigned int i = tile.top; i < tile.top + tile.height; i++) for (unsigned int j = tile.left; j < tile.left + tile.width; j++) {
+
+            double pi = -center.imag() + (3.0 * (image.top + i + 0.5) - 1.5 * image.frame_height) / zoom / image.frame_height;
+            double pr =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.frame_height;
+
+            double zr, zi, zpr, zpi, minimum = std::numeric_limits<double>::infinity(); unsigned int n = 0; fractal_initial_lane<F>(pr, pi, zr, zi, zpr, zpi, c.real(), c.imag()); double sr = zr, si = zi, spr = zpr, spi = zpi;
+
+            if constexpr (F == FractalType::Mandelbrot) if (trap_algorithm.enable_interior && trap_algorithm.fill_background && mandelbrot_bulb(pr, pi)) {
+                skipped += trap_algorithm.max_iterations, tile.interior++; continue;
+            }
+
+            for (unsigned int check = 1; n < trap_algorithm.max_iterations; n++) {
+                fractal_step_lane<F>(pr, pi, zr, zi, zpr, zpi, c.real(), c.imag()); if (zr * zr + zi * zi > bailout_norm) break; minimum = std::min(minimum, trap_function({zr, zi}));
+
+                if (trap_algorithm.enable_interior && (zr - sr) * (zr - sr) + (zi - si) * (zi - si) + (zpr - spr) * (zpr - spr) + (zpi - spi) * (zpi - spi) < tolerance) {
+                    skipped += trap_algorithm.max_iterations - n - 1; break;
+                }
+
+                if (trap_algorithm.enable_interior && n + 1 == check) sr = zr, si = zi, spr = zpr, spi = zpi, check *= 2;
+            }
+
+            bool escaped = zr * zr + zi * zi > bailout_norm; tile.iterations += std::min(n + 1, trap_algorithm.max_iterations), tile.escaped += escaped, tile.interior += !escaped;
+
+            if ((!trap_algorithm.fill_background || escaped) && minimum < std::numeric_limits<double>::infinity()) field.data[i * image.width + j] = minimum;
+        }
+
+        #pragma omp atomic
+        skipped_iterations += skipped;
+    });
+
+    return field;
+}
+
+template <typename T>
+Field trap_field(const Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Trap& trap_algorithm) {
+    if constexpr (std::is_same<T, double>()) {
+
+        std::complex<double> parameter = exp(std::complex<double>{0, 1} * double(fractal.parameter));
+
+        switch (fractal_type(fractal.name)) {
+            case FractalType::Buffalo:     return trap_kernel<FractalType::Buffalo    >(image, center, zoom, parameter, trap_algorithm);
+            case FractalType::Burningship: return trap_kernel<FractalType::Burningship>(image, center, zoom, parameter, trap_algorithm);
+            case FractalType::Julia:       return trap_kernel<FractalType::Julia      >(image, center, zoom, parameter, trap_algorithm);
+            case FractalType::Mandelbrot:  return trap_kernel<FractalType::Mandelbrot >(image, center, zoom, parameter, trap_algorithm);
+            case FractalType::Manowar:     return trap_kernel<FractalType::Manowar    >(image, center, zoom, parameter, trap_algorithm);
+            case FractalType::Phoenix:     return trap_kernel<FractalType::Phoenix    >(image, center, zoom, parameter, trap_algorithm);
+        }
+    }
+
+    auto fractal_function    = FractalFunctions<T>()        .content.at(fractal.name             );
+    auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name             );
+    auto trap_function       = TrapFunctions<T>()           .content.at(trap_algorithm.trap_index);
+
+    T tolerance = periodicity_tolerance<T>(); Field field = {std::vector<double>(image.width * image.height, std::numeric_limits<double>::quiet_NaN()), image.width, image.height, FieldType::Trap, 1}; bool mandelbrot = fractal.name == "mandelbrot";
+
+    std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter));
+
+    draw_tiles(image, [&](Tile& tile) {
+        unsigned long skipped = 0;
+
+        for (unsigned int i = tile.top; i < tile.top + tile.height; i++) for (unsigned int j = tile.left; j < tile.left + tile.width; j++) {
+
+            T im = -center.imag() + (3.0 * (image.top + i + 0.5) - 1.5 * image.frame_height) / zoom / image.frame_height;
+            T re =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.frame_height;
+
+            auto [p, z, zp] = fractal_ic_function(std::complex<T>{re, im}, parameter); std::vector<std::complex<T>> orbit; std::complex<T> z_saved = z, zp_saved = zp; unsigned int n = 0;
+
+            if (trap_algorithm.enable_interior && trap_algorithm.fill_background && mandelbrot && mandelbrot_bulb(re, im)) {
+                skipped += trap_algorithm.max_iterations, tile.interior++; continue;
+            }
+
+            for (unsigned int check = 1; n < trap_algorithm.max_iterations; n++) {
+                std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > trap_algorithm.bailout_radius * trap_algorithm.bailout_radius) break; orbit.push_back(z);
+
+                if (trap_algorithm.enable_interior && std::norm(z - z_saved) + std::norm(zp - zp_saved) < tolerance) {
+                    skipped += trap_algorithm.max_iterations - n - 1; break;
+                }
+
+                if (trap_algorithm.enable_interior && n + 1 == check) z_saved = z, zp_saved = zp, check *= 2;
+            }
+
+            bool escaped = std::norm(z) > trap_algorithm.bailout_radius * trap_algorithm.bailout_radius; tile.iterations += std::min(n + 1, trap_algorithm.max_iterations), tile.escaped += escaped, tile.interior += !escaped;
+
+            if (!trap_algorithm.fill_background || escaped) {
+
+                field.data.at(i * image.width + j) = static_cast<double>(trap_function(*std::min_element(orbit.begin(), orbit.end(), [&](const std::complex<T>& a, const std::complex<T>& b) {return trap_function(a) < trap_function(b);})));
+            }
+        }
+
+        #pragma omp atomic
+        skipped_iterations += skipped;
+    });
+
+    return field;
+}
+
+template <class C>
+void paint_field(Image& image, const Field& field, const C& color_algorithm) {
+    const double* data = field.data.data(); unsigned char* pixels = image.data.data(); unsigned int width = image.width, height = image.height; bool trap = field.type == FieldType::Trap, density = field.type == FieldType::Density; double scale = field.scale;
+
+    if constexpr (!std::is_same<C, Linear>() && !std::is_same<C, Periodic>() && !std::is_same<C, Solid>()) throw std::runtime_error("COLORING ALGORITHM FOR THIS GENERATION ALGORITHM NOT SUPPORTED");
+
+    std::array<double, 3> a = {}, b = {};
+
+    for (int c = 0; c < 3; c++) {
+        if constexpr (std::is_same<C, Linear>  ()) a[c] = color_algorithm.from[c], b[c] = color_algorithm.to[c] - color_algorithm.from[c];
+        if constexpr (std::is_same<C, Periodic>()) a[c] = color_algorithm.amplitude[c], b[c] = color_algorithm.phase[c];
+        if constexpr (std::is_same<C, Solid>   ()) a[c] = color_algorithm.color[c];
+    }
+
+    #pragma omp parallel num_threads(nthread)
+    {
+        std::vector<double> line(3 * width); double* color = line.data();
+
+        #pragma omp for
+        for (unsigned int i = 0; i < height; i++) {
+
+            const double* row = data + (size_t)i * width; unsigned char* out = pixels + 3 * (size_t)i * width;
+
+            #pragma omp simd
+            for (unsigned int j = 0; j < width; j++) {
+
+                double v = row[j];
+
+                if constexpr (std::is_same<C, Linear>()) {
+                    double t = trap ? 1 / (1 + 5 * v) : v / scale; color[3 * j + 0] = a[0] + t * b[0], color[3 * j + 1] = a[1] + t * b[1], color[3 * j + 2] = a[2] + t * b[2];
+                } else if constexpr (std::is_same<C, Periodic>()) {
+                    double x = trap ? log(v) : v;
+                    color[3 * j + 0] = (sin((trap ? a[0] * 0.03 * x : a[0] * x / scale) + b[0]) + 1) * 127.5;
+                    color[3 * j + 1] = (sin((trap ? a[1] * 0.03 * x : a[1] * x / scale) + b[1]) + 1) * 127.5;
+                    color[3 * j + 2] = (sin((trap ? a[2] * 0.03 * x : a[2] * x / scale) + b[2]) + 1) * 127.5;
+                } else {
+                    bool skip = std::isnan(v) || (density && !v); color[3 * j + 0] = skip ? NAN : a[0], color[3 * j + 1] = skip ? NAN : a[1], color[3 * j + 2] = skip ? NAN : a[2];
+                }
+            }
+
+            #pragma omp simd
+            for (unsigned int k = 0; k < 3 * width; k++) out[k] = std::isnan(color[k]) ? out[k] : (unsigned char)color[k];
+        }
+    }
+}
+
+inline void equalize_field(Field& field) {
+    std::vector<double> sorted; for (double v : field.data) if (!std::isnan(v) && (field.type != FieldType::Density || v)) sorted.push_back(v);
+
+    std::sort(sorted.begin(), sorted.end());
+
+    #pragma omp parallel for num_threads(nthread)
+    for (size_t k = 0; k < field.data.size(); k++) if (!std::isnan(field.data[k]) && (field.type != FieldType::Density || field.data[k])) {
+        double rank = (double)(std::upper_bound(sorted.begin(), sorted.end(), field.data[k]) - sorted.begin()) / sorted.size(); field.data[k] = field.type == FieldType::Trap ? 1 - rank : rank;
+    }
+
+    field.type = field.type == FieldType::Trap ? FieldType::Escape : field.type, field.scale = 1;
+}
+
+inline void write_field(const Field& field, const std::string& filename, const std::string& parameters) {
+    std::ofstream file(filename, std::ios::binary); uint32_t header[4] = {field.width, field.height, (uint32_t)field.type, (uint32_t)parameters.size()};
+
+    std::vector<float> values(field.data.begin(), field.data.end()); std::string padded = parameters; padded.resize((parameters.size() + 7) / 8 * 8, '\0');
+
+    file.write("FRACTAL1", 8).write((const char*)header, sizeof(header)).write((const char*)&field.scale, sizeof(double)).write(padded.data(), padded.size()).write((const char*)values.data(), values.size() * sizeof(float));
+
+    if (!file) throw std::runtime_error("COULD NOT WRITE THE FIELD FILE");
+}
+
+inline Field read_field(const std::string& filename) {
+    int file = open(filename.c_str(), O_RDONLY); struct stat status; if (file < 0 || fstat(file, &status)) throw std::runtime_error("COULD NOT OPEN THE FIELD FILE");
+
+    const char* map = (const char*)mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0); close(file); uint32_t header[4]; Field field;
+
+    if (map == MAP_FAILED) throw std::runtime_error("INVALID FIELD FILE");
+
+    if (status.st_size < 32 || std::string(map, 8) != "FRACTAL1") munmap((void*)map, status.st_size), throw std::runtime_error("INVALID FIELD FILE");
+
+    std::copy(map + 8, map + 24, (char*)header), std::copy(map + 24, map + 32, (char*)&field.scale); size_t offset = 32 + ((size_t)header[3] + 7) / 8 * 8;
+
+    if ((size_t)status.st_size != offset + sizeof(float) * header[0] * header[1] || header[2] > (uint32_t)FieldType::Trap) munmap((void*)map, status.st_size), throw std::runtime_error("INVALID FIELD FILE");
+
+    field.width = header[0], field.height = header[1], field.type = (FieldType)header[2], field.data.resize((size_t)field.width * field.height); const float* values = (const float*)(map + offset);
+
+    std::cout << "FIELD PARAMETERS " << std::string(map + 32, header[3]) << std::endl;
+
+    #pragma omp parallel for num_threads(nthread)
+    for (size_t k = 0; k < field.data.size(); k++) field.data[k] = values[k];
+
+    munmap((void*)map, status.st_size); return field;
+}
+
+template <class D>
+void draw_strips(Image& image, const std::string& output, const std::string& signature, unsigned int rows, const D& draw) {
+    std::string header = "P6\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n", line; size_t size = header.size() + 3UL * image.width * image.height, completed = 0; struct stat status;
+
+    if (!rows) throw std::runtime_error("STRIP NEEDS AT LEAST ONE ROW");
+
+    if (output.size() < 4 || output.substr(output.size() - 4) != ".ppm") throw std::runtime_error("STRIP RENDERING NEEDS A PPM OUTPUT FILE");
+
+    std::vector<unsigned char> done((image.height + rows - 1) / rows, 0);
+
+    std::ifstream previous(output + ".progress"); if (std::getline(previous, line) && line == signature) while (std::getline(previous, line) && !previous.eof()) completed += !done.at(std::stoul(line) / rows), done.at(std::stoul(line) / rows) = 1;
+
+    int file = open(output.c_str(), O_RDWR | O_CREAT, 0644); if (file < 0) throw std::runtime_error("COULD NOT OPEN THE OUTPUT FILE");
+
+    if (fstat(file, &status) || status.st_size != (off_t)size) std::fill(done.begin(), done.end(), 0), completed = 0;
+
+    if (ftruncate(file, size) || pwrite(file, header.data(), header.size(), 0) != (ssize_t)header.size()) throw std::runtime_error("COULD NOT WRITE THE OUTPUT FILE");
+
+    std::ofstream progress(output + ".progress", completed ? std::ios::app : std::ios::trunc); if (!completed) progress << signature << std::endl;
+
+    unsigned int height = image.height; if (completed) std::cout << "STRIP RENDERING RESUMED WITH " << completed << " OF " << done.size() << " STRIPS COMPLETED" << std::endl;
+
+    for (unsigned int top = 0; top < height; top += rows) {
+
+        if (done.at(top / rows)) continue;
+
+        image.top = top, image.height = std::min(rows, height - top); image.data.assign(3 * image.width * image.height, 0); draw();
+
+        if (pwrite(file, image.data.data(), image.data.size(), header.size() + 3UL * image.width * top) != (ssize_t)image.data.size() || fdatasync(file)) throw std::runtime_error("COULD NOT WRITE THE OUTPUT FILE");
+
+        progress << top << std::endl;
+    }
+
+    close(file), progress.close(), std::remove((output + ".progress").c_str()); image.top = 0, image.height = height, image.data = std::vector<unsigned char>();
+}
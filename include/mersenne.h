@@ -0,0 +1,343 @@
+#pragma once
+
+#include  <gmpxx.h>
+#include    <omp.h>
+#include   <chrono>
+#include  <complex>
+#include  <fstream>
+#include  <iomanip>
+#include <iostream>
+#include      <map>
+#include  <numbers>
+#include  <numeric>
+#include  <sstream>
+#include   <string>
+#include   <vector>
+
+struct LucasLehmer {
+    unsigned long p; size_t n; std::vector<unsigned long> shift; std::vector<double> weight, unweight, base, inverse, x, carry, real, imag, root_real, root_imag, third_real, third_imag; std::vector<std::complex<double>> twist; std::vector<size_t> reverse;
+};
+
+inline std::complex<double> multiply(const std::complex<double>& a, const std::complex<double>& b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+inline size_t transform_length(unsigned long p) {
+    size_t n = 16; while ((double)p / n > 23.75 - 0.25 * log2(n)) n = n % 3 ? n / 2 * 3 : n / 3 * 4; return n;
+}
+
+inline LucasLehmer lucas_lehmer(unsigned long p, size_t n) {
+    LucasLehmer ll; size_t m = n / 2, length = m % 3 ? m : m / 3; ll.p = p, ll.n = n;
+
+    ll.shift.resize(n + 1), ll.weight.resize(n), ll.unweight.resize(n), ll.base.resize(n), ll.inverse.resize(n), ll.x.resize(n), ll.carry.resize(std::gcd<size_t>(n, 64)), ll.real.resize(m), ll.imag.resize(m);
+
+    ll.root_real.resize(length), ll.root_imag.resize(length), ll.third_real.resize(m), ll.third_imag.resize(m), ll.twist.resize(m / 2 + 1), ll.reverse.resize(m);
+
+    for (size_t j = 0; j <= n; j++) ll.shift[j] = (p * j + n - 1) / n;
+
+    for (size_t j = 0; j < n; j++) {
+        double fraction = (double)(ll.shift[j] * n - p * j) / n; ll.weight[j] = exp2(fraction), ll.unweight[j] = exp2(-fraction) / m, ll.base[j] = exp2(ll.shift[j + 1] - ll.shift[j]), ll.inverse[j] = 1 / ll.base[j];
+    }
+
+    for (size_t half = 1; half < length; half *= 2) for (size_t j = 0; j < half; j++) {
+        std::complex<long double> w = std::polar(1.0L, -std::numbers::pi_v<long double> * j / half); ll.root_real[half + j] = w.real(), ll.root_imag[half + j] = w.imag();
+    }
+
+    for (size_t j = 0; j < m; j++) {
+        std::complex<long double> w = std::polar(1.0L, -2 * std::numbers::pi_v<long double> * j / m); ll.third_real[j] = w.real(), ll.third_imag[j] = w.imag();
+    }
+
+    for (size_t k = 0; k <= m / 2; k++) ll.twist[k] = std::polar(1.0L, -2 * std::numbers::pi_v<long double> * k / n);
+
+    for (size_t k = 0, bits = log2(length); k < m; k++) {
+        size_t q = k / (m / length), r = 0; for (size_t b = 0; b < bits; b++) r |= (q >> b & 1) << (bits - b - 1); ll.reverse[k] = k % (m / length) * length + r;
+    }
+
+    return ll;
+}
+
+inline void forward_butterflies(double* __restrict ar, double* __restrict ai, double* __restrict br, double* __restrict bi, const double* __restrict wr, const double* __restrict wi, size_t count) {
+    for (size_t j = 0; j < count; j++) {
+        double dr = ar[j] - br[j], di = ai[j] - bi[j]; ar[j] += br[j], ai[j] += bi[j], br[j] = dr * wr[j] - di * wi[j], bi[j] = dr * wi[j] + di * wr[j];
+    }
+}
+
+inline void inverse_butterflies(double* __restrict ar, double* __restrict ai, double* __restrict br, double* __restrict bi, const double* __restrict wr, const double* __restrict wi, size_t count) {
+    for (size_t j = 0; j < count; j++) {
+        double vr = br[j] * wr[j] + bi[j] * wi[j], vi = bi[j] * wr[j] - br[j] * wi[j]; br[j] = ar[j] - vr, bi[j] = ai[j] - vi, ar[j] += vr, ai[j] += vi;
+    }
+}
+
+inline void forward_transform(LucasLehmer& ll) {
+    size_t m = ll.n / 2, length = m % 3 ? m : m / 3; double* re = ll.real.data(), * im = ll.imag.data(), * cr = ll.root_real.data(), * ci = ll.root_imag.data(), * qr = ll.third_real.data(), * qi = ll.third_imag.data(), s = sqrt(0.75);
+
+    if (length < m) {
+        #pragma omp for
+        for (size_t j = 0; j < length; j++) {
+            double sr = re[j + length] + re[j + 2 * length], si = im[j + length] + im[j + 2 * length], dr = re[j + length] - re[j + 2 * length], di = im[j + length] - im[j + 2 * length], tr = re[j] - 0.5 * sr, ti = im[j] - 0.5 * si;
+
+            double ar = tr + s * di, ai = ti - s * dr, br = tr - s * di, bi = ti + s * dr, wr = qr[j], wi = qi[j], vr = qr[2 * j], vi = qi[2 * j];
+
+            re[j] += sr, im[j] += si, re[j + length] = ar * wr - ai * wi, im[j + length] = ar * wi + ai * wr, re[j + 2 * length] = br * vr - bi * vi, im[j + 2 * length] = br * vi + bi * vr;
+        }
+    }
+
+    for (size_t half = length / 2; half >= 1; half /= 2) {
+
+        if (m / (2 * half) >= (size_t)omp_get_num_threads()) {
+            #pragma omp for
+            for (size_t b = 0; b < m; b += 2 * half) forward_butterflies(re + b, im + b, re + b + half, im + b + half, cr + half, ci + half, half);
+        } else for (size_t b = 0; b < m; b += 2 * half) {
+            #pragma omp for
+            for (size_t j = 0; j < half; j += 64) forward_butterflies(re + b + j, im + b + j, re + b + j + half, im + b + j + half, cr + half + j, ci + half + j, std::min<size_t>(64, half - j));
+        }
+    }
+}
+
+inline void inverse_transform(LucasLehmer& ll) {
+    size_t m = ll.n / 2, length = m % 3 ? m : m / 3; double* re = ll.real.data(), * im = ll.imag.data(), * cr = ll.root_real.data(), * ci = ll.root_imag.data(), * qr = ll.third_real.data(), * qi = ll.third_imag.data(), s = sqrt(0.75);
+
+    for (size_t half = 1; half < length; half *= 2) {
+
+        if (m / (2 * half) >= (size_t)omp_get_num_threads()) {
+            #pragma omp for
+            for (size_t b = 0; b < m; b += 2 * half) inverse_butterflies(re + b, im + b, re + b + half, im + b + half, cr + half, ci + half, half);
+        } else for (size_t b = 0; b < m; b += 2 * half) {
+            #pragma omp for
+            for (size_t j = 0; j < half; j += 64) inverse_butterflies(re + b + j, im + b + j, re + b + j + half, im + b + j + half, cr + half + j, ci + half + j, std::min<size_t>(64, half - j));
+        }
+    }
+
+    if (length < m) {
+        #pragma omp for
+        for (size_t j = 0; j < length; j++) {
+            double wr = qr[j], wi = qi[j], vr = qr[2 * j], vi = qi[2 * j], ar = re[j + length] * wr + im[j + length] * wi, ai = im[j + length] * wr - re[j + length] * wi;
+
+            double br = re[j + 2 * length] * vr + im[j + 2 * length] * vi, bi = im[j + 2 * length] * vr - re[j + 2 * length] * vi, sr = ar + br, si = ai + bi, dr = ar - br, di = ai - bi, tr = re[j] - 0.5 * sr, ti = im[j] - 0.5 * si;
+
+            re[j] += sr, im[j] += si, re[j + length] = tr - s * di, im[j + length] = ti + s * dr, re[j + 2 * length] = tr + s * di, im[j + 2 * length] = ti - s * dr;
+        }
+    }
+}
+
+inline double square_minus_two(LucasLehmer& ll) {
+    size_t n = ll.n, m = n / 2, lines = ll.carry.size(), length = n / lines; double roundoff = 0; std::fill(ll.carry.begin(), ll.carry.end(), 0), ll.carry[0] = -2;
+
+    #pragma omp parallel
+    {
+        #pragma omp for
+        for (size_t k = 0; k < m; k++) ll.real[k] = ll.x[2 * k] * ll.weight[2 * k], ll.imag[k] = ll.x[2 * k + 1] * ll.weight[2 * k + 1];
+
+        forward_transform(ll);
+
+        #pragma omp for
+        for (size_t k = 0; k <= m / 2; k++) {
+            size_t u = ll.reverse[k], v = ll.reverse[k ? m - k : 0]; std::complex<double> a = {ll.real[u], ll.imag[u]}, b = {ll.real[v], ll.imag[v]}, i = {0, 1};
+
+            std::complex<double> even = (a + std::conj(b)) * 0.5, odd = multiply(a - std::conj(b), {0, -0.5}), c = even + multiply(ll.twist[k], odd), d = std::conj(even) - multiply(std::conj(ll.twist[k]), std::conj(odd));
+
+            c = multiply(c, c), d = multiply(d, d), even = (c + std::conj(d)) * 0.5, odd = multiply((c - std::conj(d)) * 0.5, std::conj(ll.twist[k])), a = even + multiply(i, odd), b = std::conj(even) + multiply(i, std::conj(odd));
+
+            ll.real[u] = a.real(), ll.imag[u] = a.imag(); if (k != 0 && 2 * k != m) ll.real[v] = b.real(), ll.imag[v] = b.imag();
+        }
+
+        inverse_transform(ll);
+
+        #pragma omp for reduction(max:roundoff)
+        for (size_t g = 0; g < lines; g += 8) for (size_t i = 0; i < length; i++) for (size_t l = g; l < g + 8; l++) {
+            size_t j = l * length + i; double v = (j % 2 ? ll.imag[j / 2] : ll.real[j / 2]) * ll.unweight[j], r = rint(v); roundoff = std::max(roundoff, std::abs(v - r)), r += ll.carry[l], ll.carry[l] = rint(r * ll.inverse[j]), ll.x[j] = r - ll.carry[l] * ll.base[j];
+        }
+    }
+
+    for (size_t l = 0; l < lines; l++) for (size_t j = (l + 1) * length % n; ll.carry[l] != 0; j = j + 1 < n ? j + 1 : 0) {
+        double r = ll.x[j] + ll.carry[l]; ll.carry[l] = rint(r * ll.inverse[j]), ll.x[j] = r - ll.carry[l] * ll.base[j];
+    }
+
+    return roundoff;
+}
+
+inline mpz_class residue(const LucasLehmer& ll, const mpz_class& M) {
+    std::vector<uint64_t> positive(ll.p / 64 + 2, 0), negative(ll.p / 64 + 2, 0); mpz_class a, b;
+
+    for (size_t j = 0; j < ll.n; j++) {
+        std::vector<uint64_t>& words = ll.x[j] < 0 ? negative : positive; uint64_t v = std::abs(ll.x[j]), s = ll.shift[j];
+
+        words[s / 64] |= v << s % 64; if (s % 64) words[s / 64 + 1] |= v >> (64 - s % 64);
+    }
+
+    mpz_import(a.get_mpz_t(), positive.size(), -1, 8, 0, 0, positive.data()), mpz_import(b.get_mpz_t(), negative.size(), -1, 8, 0, 0, negative.data()), a -= b;
+
+    if (a < 0) a += M;
+
+    if (a >= M) a -= M;
+
+    return a;
+}
+
+inline void load(LucasLehmer& ll, const mpz_class& s) {
+    std::vector<uint64_t> words(ll.p / 64 + 2, 0); double c = 0; mpz_export(words.data(), nullptr, -1, 8, 0, 0, s.get_mpz_t());
+
+    for (size_t j = 0; j < ll.n; j++) {
+        uint64_t start = ll.shift[j], bits = ll.shift[j + 1] - start, v = words[start / 64] >> start % 64; if (start % 64 + bits > 64) v |= words[start / 64 + 1] << (64 - start % 64);
+
+        double r = (v & ((1ULL << bits) - 1)) + c; c = rint(r / ll.base[j]), ll.x[j] = r - c * ll.base[j];
+    }
+
+    ll.x[0] += c;
+}
+
+inline bool lucas_lehmer_gmp(unsigned long p) {
+    mpz_class M = (mpz_class(1) << p) - 1, s = 4, t;
+
+    for (unsigned long i = 0; i + 2 < p; i++) {
+        mpz_mul(t.get_mpz_t(), s.get_mpz_t(), s.get_mpz_t()), mpz_tdiv_q_2exp(s.get_mpz_t(), t.get_mpz_t(), p), mpz_tdiv_r_2exp(t.get_mpz_t(), t.get_mpz_t(), p), s += t;
+
+        if (s >= M) s -= M;
+
+        if (s < 2) s += M;
+
+        s -= 2;
+    }
+
+    return s == 0;
+}
+
+inline void save_residue(const std::string& filename, unsigned long p, unsigned long iteration, const mpz_class& s) {
+    std::vector<uint64_t> words(p / 64 + 1, 0); mpz_export(words.data(), nullptr, -1, 8, 0, 0, s.get_mpz_t()); uint64_t header[3] = {p, iteration, words.size()};
+
+    std::ofstream file(filename + ".tmp", std::ios::binary); file.write((char*)header, sizeof(header)).write((char*)words.data(), 8 * words.size()); file.close();
+
+    if (!file || std::rename((filename + ".tmp").c_str(), filename.c_str())) throw std::runtime_error("COULD NOT WRITE THE RESIDUE FILE");
+}
+
+inline bool load_residue(const std::string& filename, unsigned long p, unsigned long& iteration, mpz_class& s) {
+    std::ifstream file(filename, std::ios::binary); uint64_t header[3]; if (!file.read((char*)header, sizeof(header)) || header[0] != p || header[2] != p / 64 + 1) return false;
+
+    std::vector<uint64_t> words(header[2]); if (!file.read((char*)words.data(), 8 * words.size())) return false;
+
+    mpz_import(s.get_mpz_t(), words.size(), -1, 8, 0, 0, words.data()), iteration = header[1]; return true;
+}
+
+inline bool lucas_lehmer_dwt(unsigned long p, const std::string& checkpoint = "", unsigned long interval = 10000) {
+    mpz_class M = (mpz_class(1) << p) - 1, verified = 4, suspect = -1, s; unsigned long verified_iteration = 0, suspect_iteration = 0, iteration = 0; double peak = 0;
+
+    if (!checkpoint.empty() && load_residue(checkpoint, p, iteration, s) && iteration > 0 && iteration + 2 < p && s < M && mpz_jacobi(mpz_class(s - 2).get_mpz_t(), M.get_mpz_t()) != 1) verified = s, verified_iteration = iteration;
+
+    LucasLehmer ll = lucas_lehmer(p, transform_length(p)); load(ll, verified);
+
+    for (unsigned long i = verified_iteration; i + 2 < p;) {
+
+        double roundoff = square_minus_two(ll); i++;
+
+        if (roundoff > 0.4) {
+            std::cerr << "ROUNDOFF ERROR " << roundoff << " AT ITERATION " << i << " OF M" << p << ", RESTARTING FROM ITERATION " << verified_iteration << " WITH TRANSFORM LENGTH " << (ll.n % 3 ? ll.n / 2 * 3 : ll.n / 3 * 4) << std::endl;
+
+            ll = lucas_lehmer(p, ll.n % 3 ? ll.n / 2 * 3 : ll.n / 3 * 4), load(ll, verified), i = verified_iteration, peak = 0; continue;
+        }
+
+        peak = std::max(peak, roundoff); if (i % interval && i + 2 < p) continue;
+
+        mpz_class s = residue(ll, M);
+
+        if (mpz_jacobi(mpz_class(s - 2).get_mpz_t(), M.get_mpz_t()) == 1) {
+            bool grow = (s == suspect && i == suspect_iteration) || peak > 0.35; size_t n = grow ? (ll.n % 3 ? ll.n / 2 * 3 : ll.n / 3 * 4) : ll.n;
+
+            if (n > 2 * transform_length(p)) throw std::runtime_error("JACOBI CHECK OF M" + std::to_string(p) + " FAILED REPEATEDLY AT ITERATION " + std::to_string(i));
+
+            std::cerr << "JACOBI CHECK FAILED AT ITERATION " << i << " OF M" << p << ", RESTARTING FROM ITERATION " << verified_iteration << " WITH TRANSFORM LENGTH " << n << std::endl;
+
+            if (grow) ll = lucas_lehmer(p, n);
+
+            suspect = s, suspect_iteration = i, load(ll, verified), i = verified_iteration, peak = 0; continue;
+        }
+
+        verified = s, verified_iteration = i, peak = 0; if (!checkpoint.empty() && i + 2 < p) save_residue(checkpoint, p, i, s);
+    }
+
+    if (!checkpoint.empty()) std::remove(checkpoint.c_str());
+
+    return verified == 0;
+}
+
+inline bool is_mersenne(unsigned long p, const std::string& checkpoint = "") {
+    return p == 2 || (p > 2 && (p < 131072 ? lucas_lehmer_gmp(p) : lucas_lehmer_dwt(p, checkpoint)));
+}
+
+inline uint64_t power_of_two(unsigned long p, uint64_t q) {
+    unsigned __int128 r = 1; for (int b = std::bit_width(p) - 1; b >= 0; b--) r = r * r % q, r = p >> b & 1 ? (r << 1) % q : r; return r;
+}
+
+inline uint64_t trial_factor(unsigned long p) {
+    long bits = std::min<long>({64, (long)(p + 1) / 2, 3L * (long)std::bit_width(p) - 12});
+
+    for (unsigned __int128 q = 2 * p + 1; bits > 0 && q >> bits == 0; q += 2 * p) if ((q % 8 == 1 || q % 8 == 7) && q % 3 && q % 5 && q % 7 && power_of_two(p, q) == 1) return q;
+
+    return 0;
+}
+
+inline std::vector<unsigned long> prime_exponents(unsigned long from, unsigned long to, const std::vector<unsigned long>& base) {
+    std::vector<unsigned char> composite(to - from, 0); std::vector<unsigned long> primes;
+
+    for (unsigned long q : base) for (unsigned long j = std::max(q * q, (from + q - 1) / q * q); j < to; j += q) composite[j - from] = 1;
+
+    for (unsigned long j = std::max(from, 2UL); j < to; j++) if (!composite[j - from]) primes.push_back(j);
+
+    return primes;
+}
+
+inline long elapsed(std::chrono::time_point<std::chrono::high_resolution_clock> from) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock().now() - from).count();
+}
+
+inline std::string format_ms(long ms) {
+    long h = ms / 3600000, m = ms % 3600000 / 60000, s = ms % 60000 / 1000; ms = ms % 1000;
+
+    std::stringstream ss; ss << std::setfill('0') << std::setw(2) << h <<  ":" << std::setw(2) << m << ":" << std::setw(2) << s << "." << std::setw(3) << ms;
+
+    return ss.str();
+}
+
+inline void generate(unsigned long limit, const std::string& checkpoint) {
+    auto start_time = std::chrono::high_resolution_clock().now(); std::string signature = "MERSENNE " + std::to_string(limit), line; std::vector<unsigned long> base, found; unsigned long resume = 0; std::ofstream progress;
+
+    std::ifstream previous(checkpoint); if (!checkpoint.empty() && std::getline(previous, line) && line == signature) while (std::getline(previous, line) && !previous.eof()) {
+        std::stringstream ss(line); unsigned long p; bool prime; ss >> p >> prime; resume = p; if (prime) found.push_back(p);
+    }
+
+    if (!checkpoint.empty()) progress.open(checkpoint, resume ? std::ios::app : std::ios::trunc);
+
+    if (progress.is_open() && !resume) progress << signature << std::endl;
+
+    for (size_t k = 0; k < found.size(); k++) std::cout << std::setw(2) << k + 1 << " (" << format_ms(elapsed(start_time)) << "): " << found.at(k) << std::endl;
+
+    if (resume) std::cout << "GENERATION RESUMED AFTER EXPONENT " << resume << std::endl;
+
+    for (unsigned long q = 2; q * q <= limit; q++) if (std::all_of(base.begin(), base.end(), [q](unsigned long b) {return q % b;})) base.push_back(q);
+
+    std::vector<unsigned long> exponents; std::map<unsigned long, int> results; unsigned long from = resume + 1; size_t next = 0; omp_set_max_active_levels(1);
+
+    #pragma omp parallel
+    for (unsigned long p = 0;;) {
+
+        #pragma omp critical(generate)
+        {
+            while (next == exponents.size() && from <= limit) exponents = prime_exponents(from, std::min(from + (1 << 20), limit + 1), base), from += 1 << 20, next = 0;
+
+            p = next < exponents.size() ? exponents.at(next++) : 0; if (p) results[p] = -1;
+        }
+
+        if (!p) break;
+
+        bool prime = !trial_factor(p) && is_mersenne(p, checkpoint.empty() ? "" : checkpoint + "." + std::to_string(p));
+
+        #pragma omp critical(generate)
+        for (results[p] = prime; !results.empty() && results.begin()->second >= 0; results.erase(results.begin())) {
+
+            if (results.begin()->second) found.push_back(results.begin()->first), std::cout << std::setw(2) << found.size() << " (" << format_ms(elapsed(start_time)) << "): " << found.back() << std::endl;
+
+            if (progress.is_open()) progress << results.begin()->first << " " << results.begin()->second << std::endl;
+        }
+    }
+
+    if (progress.is_open()) progress.close(), std::remove(checkpoint.c_str());
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include   <algorithm>
+#include       <cmath>
+#include      <limits>
+#include       <tuple>
+#include <type_traits>
+
+inline double quick_two_sum(double a, double b, double& e) {
+    double s = a + b; e = b - (s - a); return s;
+}
+
+inline double two_sum(double a, double b, double& e) {
+    double s = a + b, v = s - a; e = (a - (s - v)) + (b - v); return s;
+}
+
+inline double two_prod(double a, double b, double& e) {
+    double p = a * b; e = std::fma(a, b, -p); return p;
+}
+
+inline void three_sum(double& a, double& b, double& c) {
+    double t1, t2, t3; t1 = two_sum(a, b, t2), a = two_sum(c, t1, t3), b = two_sum(t2, t3, c);
+}
+
+inline void three_sum2(double& a, double& b, double& c) {
+    double t1, t2, t3; t1 = two_sum(a, b, t2), a = two_sum(c, t1, t3), b = t2 + t3;
+}
+
+struct DoubleDouble {
+    static constexpr int terms = 2; double x[2];
+
+    DoubleDouble(double a = 0, double b = 0) : x{a, b} {}
+
+    explicit operator double() const {return x[0] + x[1];}
+
+    explicit operator int() const;
+
+    DoubleDouble operator-() const {return {-x[0], -x[1]};}
+
+    friend DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+        double s, e, t, f; s = two_sum(a.x[0], b.x[0], e), t = two_sum(a.x[1], b.x[1], f), e += t, s = quick_two_sum(s, e, e), e += f, s = quick_two_sum(s, e, e); return {s, e};
+    }
+
+    friend DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+        double p, e; p = two_prod(a.x[0], b.x[0], e), e += a.x[0] * b.x[1] + a.x[1] * b.x[0], p = quick_two_sum(p, e, e); return {p, e};
+    }
+
+    friend DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+        double q1 = a.x[0] / b.x[0]; DoubleDouble r = a - q1 * b; double q2 = r.x[0] / b.x[0]; r = r - q2 * b; double q3 = r.x[0] / b.x[0], e; q1 = quick_two_sum(q1, q2, e); return DoubleDouble(q1, e) + q3;
+    }
+
+    friend DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) {return a + -b;}
+};
+
+struct QuadDouble {
+    static constexpr int terms = 4; double x[4];
+
+    QuadDouble(double a = 0, double b = 0, double c = 0, double d = 0) : x{a, b, c, d} {}
+
+    explicit operator double() const {return x[0] + x[1];}
+
+    explicit operator int() const;
+
+    QuadDouble operator-() const {return {-x[0], -x[1], -x[2], -x[3]};}
+
+    static QuadDouble renormalize(double c0, double c1, double c2, double c3, double c4) {
+        double s0, s1, s2 = 0, s3 = 0; if (std::isinf(c0)) return {c0, c1, c2, c3};
+
+        s0 = quick_two_sum(c3, c4, c4), s0 = quick_two_sum(c2, s0, c3), s0 = quick_two_sum(c1, s0, c2), c0 = quick_two_sum(c0, s0, c1), s0 = c0, s1 = c1;
+
+        if (s1 != 0) {
+            s1 = quick_two_sum(s1, c2, s2);
+            if (s2 != 0) {s2 = quick_two_sum(s2, c3, s3); if (s3 != 0) s3 += c4; else s2 += c4;}
+            else {s1 = quick_two_sum(s1, c3, s2); if (s2 != 0) s2 = quick_two_sum(s2, c4, s3); else s1 = quick_two_sum(s1, c4, s2);}
+        } else {
+            s0 = quick_two_sum(s0, c2, s1);
+            if (s1 != 0) {s1 = quick_two_sum(s1, c3, s2); if (s2 != 0) s2 = quick_two_sum(s2, c4, s3); else s1 = quick_two_sum(s1, c4, s2);}
+            else {s0 = quick_two_sum(s0, c3, s1); if (s1 != 0) s1 = quick_two_sum(s1, c4, s2); else s0 = quick_two_sum(s0, c4, s1);}
+        }
+
+        return {s0, s1, s2, s3};
+    }
+
+    friend QuadDouble operator+(const QuadDouble& a, const QuadDouble& b) {
+        double s0, s1, s2, s3, t0, t1, t2, t3;
+
+        s0 = two_sum(a.x[0], b.x[0], t0), s1 = two_sum(a.x[1], b.x[1], t1), s2 = two_sum(a.x[2], b.x[2], t2), s3 = two_sum(a.x[3], b.x[3], t3);
+
+        s1 = two_sum(s1, t0, t0), three_sum(s2, t0, t1), three_sum2(s3, t0, t2), t0 = t0 + t1 + t3; return renormalize(s0, s1, s2, s3, t0);
+    }
+
+    friend QuadDouble operator*(const QuadDouble& a, const QuadDouble& b) {
+        double p0, p1, p2, p3, p4, p5, q0, q1, q2, q3, q4, q5, s0, s1, s2, t0, t1;
+
+        p0 = two_prod(a.x[0], b.x[0], q0), p1 = two_prod(a.x[0], b.x[1], q1), p2 = two_prod(a.x[1], b.x[0], q2);
+        p3 = two_prod(a.x[0], b.x[2], q3), p4 = two_prod(a.x[1], b.x[1], q4), p5 = two_prod(a.x[2], b.x[0], q5);
+
+        three_sum(p1, p2, q0), three_sum(p2, q1, q2), three_sum(p3, p4, p5);
+
+        s0 = two_sum(p2, p3, t0), s1 = two_sum(q1, p4, t1), s2 = q2 + p5, s1 = two_sum(s1, t0, t0), s2 += t0 + t1;
+
+        s1 += a.x[0] * b.x[3] + a.x[1] * b.x[2] + a.x[2] * b.x[1] + a.x[3] * b.x[0] + q0 + q3 + q4 + q5; return renormalize(p0, p1, s0, s1, s2);
+    }
+
+    friend QuadDouble operator/(const QuadDouble& a, const QuadDouble& b) {
+        double q[5]; QuadDouble r = a;
+
+        for (int k = 0; k < 5; k++) q[k] = r.x[0] / b.x[0], r = r - q[k] * b;
+
+        return renormalize(q[0], q[1], q[2], q[3], q[4]);
+    }
+
+    friend QuadDouble operator-(const QuadDouble& a, const QuadDouble& b) {return a + -b;}
+};
+
+template <class M> concept MultiDouble = std::is_same_v<M, DoubleDouble> || std::is_same_v<M, QuadDouble>;
+
+template <MultiDouble M> M& operator+=(M& a, const M& b) {return a = a + b;}
+template <MultiDouble M> M& operator-=(M& a, const M& b) {return a = a - b;}
+template <MultiDouble M> M& operator*=(M& a, const M& b) {return a = a * b;}
+template <MultiDouble M> M& operator/=(M& a, const M& b) {return a = a / b;}
+
+template <MultiDouble M> bool operator==(const M& a, const M& b) {for (int k = 0; k < M::terms; k++) if (a.x[k] != b.x[k]) return false; return true;}
+template <MultiDouble M> bool operator< (const M& a, const M& b) {for (int k = 0; k < M::terms; k++) if (a.x[k] != b.x[k]) return a.x[k] < b.x[k]; return false;}
+
+template <MultiDouble M> bool operator!=(const M& a, const M& b) {return !(a == b);}
+template <MultiDouble M> bool operator> (const M& a, const M& b) {return b < a;}
+template <MultiDouble M> bool operator<=(const M& a, const M& b) {return !(b < a);}
+template <MultiDouble M> bool operator>=(const M& a, const M& b) {return !(a < b);}
+
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator+(const M& a, T b) {return a + M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator-(const M& a, T b) {return a - M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator*(const M& a, T b) {return a * M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator/(const M& a, T b) {return a / M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator+(T a, const M& b) {return M(a) + b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator-(T a, const M& b) {return M(a) - b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator*(T a, const M& b) {return M(a) * b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M operator/(T a, const M& b) {return M(a) / b;}
+
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M& operator+=(M& a, T b) {return a = a + M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M& operator-=(M& a, T b) {return a = a - M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M& operator*=(M& a, T b) {return a = a * M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> M& operator/=(M& a, T b) {return a = a / M(b);}
+
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator==(const M& a, T b) {return a == M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator!=(const M& a, T b) {return a != M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator< (const M& a, T b) {return a <  M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator> (const M& a, T b) {return a >  M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator<=(const M& a, T b) {return a <= M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator>=(const M& a, T b) {return a >= M(b);}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator==(T a, const M& b) {return M(a) == b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator!=(T a, const M& b) {return M(a) != b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator< (T a, const M& b) {return M(a) <  b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator> (T a, const M& b) {return M(a) >  b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator<=(T a, const M& b) {return M(a) <= b;}
+template <MultiDouble M, typename T> requires std::is_arithmetic_v<T> bool operator>=(T a, const M& b) {return M(a) >= b;}
+
+template <MultiDouble M> M abs(const M& a) {return a.x[0] < 0 ? -a : a;}
+
+template <MultiDouble M> M floor(const M& a) {
+    M result; for (int k = 0; k < M::terms; k++) if (result.x[k] = std::floor(a.x[k]); result.x[k] != a.x[k]) break; return result + M(0);
+}
+
+template <MultiDouble M> M round(const M& a) {return a < 0 ? -floor(0.5 - a) : floor(a + 0.5);}
+
+inline DoubleDouble::operator int() const {return (int)std::clamp((x[0] < 0 ? -floor(-*this) : floor(*this)).x[0], -2147483648.0, 2147483647.0);}
+inline QuadDouble::operator   int() const {return (int)std::clamp((x[0] < 0 ? -floor(-*this) : floor(*this)).x[0], -2147483648.0, 2147483647.0);}
+
+template <MultiDouble M> M sqrt(const M& a) {
+    if (a.x[0] <= 0) return M(std::sqrt(a.x[0]));
+
+    M y = std::sqrt(a.x[0]);
+
+    for (int k = 1; k < M::terms; k *= 2) y += (a - y * y) / (2 * y);
+
+    return y;
+}
+
+template <MultiDouble M> M exp(const M& a) {
+    if (std::abs(a.x[0]) > 709) return M(std::exp(a.x[0]));
+
+    int k = std::max(0, std::ilogb(a.x[0]) + 5); M r = a / std::ldexp(1.0, k), term = 1, sum = 1;
+
+    for (int n = 1; std::abs(term.x[0]) > std::ldexp(1.0, -std::numeric_limits<M>::digits - 4); n++) term = term * r / n, sum += term;
+
+    for (int n = 0; n < k; n++) sum *= sum;
+
+    return sum;
+}
+
+template <MultiDouble M> M log(const M& a) {
+    if (a.x[0] <= 0) return M(std::log(a.x[0]));
+
+    M y = std::log(a.x[0]);
+
+    for (int k = 1; k < M::terms; k *= 2) y += a * exp(-y) - 1;
+
+    return y;
+}
+
+template <MultiDouble M> M log2(const M& a) {
+    static const M ln2 = log(M(2)); return log(a) / ln2;
+}
+
+template <MultiDouble M> std::pair<M, M> sincos(const M& a) {
+    int k = std::max(0, std::ilogb(a.x[0]) + 5); M r = a / std::ldexp(1.0, k), r2 = r * r, term = r, s = r, c = 1;
+
+    for (int n = 2; std::abs(term.x[0]) > std::ldexp(1.0, -std::numeric_limits<M>::digits - 4); n += 2) term = -term * r2 / (n * (n + 1)), s += term;
+
+    term = 1; for (int n = 1; std::abs(term.x[0]) > std::ldexp(1.0, -std::numeric_limits<M>::digits - 4); n += 2) term = -term * r2 / (n * (n + 1)), c += term;
+
+    for (int n = 0; n < k; n++) std::tie(s, c) = std::make_pair(2 * s * c, c * c - s * s);
+
+    return {s, c};
+}
+
+template <MultiDouble M> M sin(const M& a) {return sincos(a).first; }
+template <MultiDouble M> M cos(const M& a) {return sincos(a).second;}
+
+namespace std {
+    template <> struct numeric_limits<DoubleDouble> : numeric_limits<double> {
+        static constexpr int digits = 106; static DoubleDouble epsilon() {return ldexp(1.0, -104);}
+    };
+
+    template <> struct numeric_limits<QuadDouble> : numeric_limits<double> {
+        static constexpr int digits = 212; static QuadDouble epsilon() {return ldexp(1.0, -209);}
+    };
+}
@@ -1,14 +1,15 @@
 #!/bin/bash
 
-I=$(shuf -i 0-1000000000 -n 1); CORES=1; random() {
+I=$(shuf -i 0-1000000000 -n 1); CORES=1; BATCH=0; random() {
     RANDOM=$4; awk -v min=$1 -v max=$2 -v seed=$RANDOM -v return_int=$3 'BEGIN {srand(seed); print (return_int == 1) ? int(min + rand() * (max - min + 1)) : min + rand() * (max - min)}'
 }
 
-while getopts "c:s:h" ARG; do
+while getopts "bc:s:h" ARG; do
     case $ARG in
+        b) BATCH=1;;
         c) CORES=$OPTARG;;
         s)     I=$OPTARG;;
-        h) echo "USAGE: $0 [-c CORES] [-s SEED] [-h]"; exit 0;;
+        h) echo "USAGE: $0 [-b] [-c CORES] [-s SEED] [-h]"; exit 0;;
         *) echo "INVALID OPTION: $ARG"; exit 1;;
     esac
 done && I0=$I
@@ -116,4 +117,8 @@ COLORING_PARAMS=("-l $LINEAR_1 $LINEAR_2 $LINEAR_3 $LINEAR_4 $LINEAR_5 $LINEAR_6
 # GENERATION
 # ======================================================================================================================================================================================================
 
-echo -n "RANDOM=$I0 " && set -x && ./bin/fractal -c $CENTER_REAL $CENTER_IMAG -f ${FRACTALS[$FRACTAL_INDEX]} $PARAMETER -z $ZOOM ${ALGORITHM_PARAMS[$ALGORITHM_INDEX]} ${COLORING_PARAMS[$COLORING_INDEX]} -n $CORES
+ARGUMENTS="-c $CENTER_REAL $CENTER_IMAG -f ${FRACTALS[$FRACTAL_INDEX]} $PARAMETER -z $ZOOM ${ALGORITHM_PARAMS[$ALGORITHM_INDEX]} ${COLORING_PARAMS[$COLORING_INDEX]} -n $CORES"
+
+[ $BATCH -eq 1 ] && echo "$ARGUMENTS -o fractal_$I0.png" && exit 0
+
+echo -n "RANDOM=$I0 " && set -x && ./bin/fractal $ARGUMENTS
@@ -0,0 +1,219 @@
+#include <argparse.hpp>
+#include       <bcon.h>
+#include    <collatz.h>
+#include    <fractal.h>
+#include   <mersenne.h>
+
+#include       <iomanip>
+#include <unordered_map>
+
+struct Benchmark {
+    std::string name, unit; std::function<double()> run;
+};
+
+struct Result {
+    std::string name, unit; double value, seconds, work;
+};
+
+std::string random_digits(size_t digits, const std::string& character_map, uint64_t seed) {
+    std::string number(digits, character_map.at(0));
+
+    for (size_t k = 0; k < digits; k++) number.at(k) = character_map.at(1 + splitmix(seed + k) % (character_map.size() - 1));
+
+    return number;
+}
+
+double tile_iterations() {
+    unsigned long iterations = 0; for (const Tile& tile : tile_statistics) iterations += tile.iterations; return iterations;
+}
+
+template <typename T>
+void add_fractal_benchmarks(std::vector<Benchmark>& benchmarks, const std::string& precision, unsigned int side, unsigned long samples) {
+    Image image = {{}, side, side, 0, side}; std::complex<T> center = {T(0), T(0)}; T zoom = T(1);
+
+    Escape escape_algorithm = {10, 256, 8, true, false, false, false}; Trap trap_algorithm = {100, 256, 2, false, false}; Density density_algorithm = {10, 0.02, 80, 1, 64, 1000, samples, false, false};
+
+    for (std::string name : {"buffalo", "burningship", "julia", "mandelbrot", "manowar", "phoenix"}) {
+
+        Fractal fractal = {name, 1.57};
+
+        benchmarks.push_back({"fractal/escape/"  + precision + "/" + name, "iterations/s", [=]() {tile_statistics.clear(); escape_field<T>(image, fractal, center, zoom, escape_algorithm); return tile_iterations();}});
+        benchmarks.push_back({"fractal/trap/"    + precision + "/" + name, "iterations/s", [=]() {tile_statistics.clear(); trap_field<T>  (image, fractal, center, zoom, trap_algorithm  ); return tile_iterations();}});
+        benchmarks.push_back({"fractal/density/" + precision + "/" + name, "samples/s",    [=]() {density_field<T>(image, fractal, center, zoom, density_algorithm); return (double)samples;}});
+    }
+}
+
+std::vector<Benchmark> benchmarks(bool slow) {
+    std::vector<Benchmark> benchmarks; std::string character_map = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    add_fractal_benchmarks<double      >(benchmarks, "double", 256, 1000000);
+    add_fractal_benchmarks<DoubleDouble>(benchmarks, "dd",     64,  50000  );
+    add_fractal_benchmarks<QuadDouble  >(benchmarks, "qd",     32,  10000  );
+    add_fractal_benchmarks<mpfr::mpreal>(benchmarks, "mpreal", 32,  10000  );
+
+    for (auto [name, re, im] : std::vector<std::tuple<std::string, std::string, std::string>>{{"buffalo", "-1.5", "0"}, {"burningship", "-1.75", "-0.03"}, {"mandelbrot", "-0.75", "0.1"}}) {
+
+        Image image = {{}, 256, 256, 0, 256}; Fractal fractal = {name, 0}; std::complex<mpfr::mpreal> center = {mpfr::mpreal(re), mpfr::mpreal(im)}; Escape escape_algorithm = {10, 1024, 8, true, false, false, false};
+
+        benchmarks.push_back({"fractal/perturbation/" + name, "iterations/s", [=]() {tile_statistics.clear(); perturbation_field(image, fractal, center, mpfr::mpreal(1000), escape_algorithm, {true}); return tile_iterations();}});
+    }
+
+    std::vector<unsigned int> exponents = {521, 1279, 2203, 4423, 9689, 11213, 19937}; if (slow) exponents.push_back(132049);
+
+    for (unsigned int p : exponents) benchmarks.push_back({"mersenne/is_mersenne/" + std::to_string(p), "iterations/s", [p]() {
+        if (!is_mersenne(p)) throw std::runtime_error("THE MERSENNE NUMBER WITH EXPONENT '" + std::to_string(p) + "' WAS NOT RECOGNIZED AS PRIME");
+
+        return p - 2.0;
+    }});
+
+    for (unsigned int p : {4423, 11213}) benchmarks.push_back({"mersenne/lucas_lehmer_dwt/" + std::to_string(p), "iterations/s", [p]() {
+        if (!lucas_lehmer_dwt(p)) throw std::runtime_error("THE MERSENNE NUMBER WITH EXPONENT '" + std::to_string(p) + "' WAS NOT RECOGNIZED AS PRIME");
+
+        return p - 2.0;
+    }});
+
+    for (size_t digits : {100, 1000, 3000}) benchmarks.push_back({"collatz/series_length/" + std::to_string(digits), "steps/s", [digits]() {
+        return (double)series_length(mpz_class(random_digits(digits, "0123456789", digits)));
+    }});
+
+    for (size_t digits : {100, 1000, 3000}) {
+
+        mpz_class n(random_digits(digits, "0123456789", digits)); unsigned long steps = series_length(n);
+
+        benchmarks.push_back({"collatz/series_maximum/" + std::to_string(digits), "steps/s", [=]() {
+            if (series_maximum(n) < n) throw std::runtime_error("THE MAXIMUM OF THE SERIES WAS BELOW ITS START");
+
+            return (double)steps;
+        }});
+    }
+
+    benchmarks.push_back({"collatz/sweep_length", "values/s", []() {
+        unsigned long length, total = 0; for (uint64_t n = 1UL << 40; n < (1UL << 40) + 65536; n++) sweep_length(n, collatz_tables(), length), total += length;
+
+        if (total == 0) throw std::runtime_error("THE SWEEP DID NOT COMPUTE ANY LENGTH");
+
+        return 65536.0;
+    }});
+
+    for (size_t digits : {100, 1000, 10000, 1000000}) {
+
+        std::string number = random_digits(digits, character_map, digits); mpz_class decimal = base_to_decimal(number, 36, character_map);
+
+        benchmarks.push_back({"bcon/base_to_decimal/" + std::to_string(digits), "digits/s", [=]() {
+            if (base_to_decimal(number, 36, character_map) != decimal) throw std::runtime_error("THE NUMBER '" + number + "' WAS CONVERTED INCORRECTLY");
+
+            return (double)digits;
+        }});
+
+        benchmarks.push_back({"bcon/decimal_to_base/" + std::to_string(digits), "digits/s", [=]() {
+            if (decimal_to_base(decimal, 36, character_map) != number) throw std::runtime_error("THE NUMBER '" + decimal.get_str() + "' WAS CONVERTED INCORRECTLY");
+
+            return (double)digits;
+        }});
+    }
+
+    std::vector<std::string> numbers; Batch batch = make_batch(10, 36, character_map, character_map); for (size_t k = 0; k < 65536; k++) numbers.push_back(random_digits(1 + k % 38, "0123456789", k));
+
+    benchmarks.push_back({"bcon/convert_line", "numbers/s", [=]() {
+        std::string out; for (const std::string& number : numbers) convert_line(number.data(), number.size(), batch, out);
+
+        if (out.empty()) throw std::runtime_error("THE BATCH WAS NOT CONVERTED");
+
+        return (double)numbers.size();
+    }});
+
+    return benchmarks;
+}
+
+Result measure(const Benchmark& benchmark, unsigned int repeat, double duration) {
+    Result result = {benchmark.name, benchmark.unit, 0, 0, 0};
+
+    for (unsigned int k = 0; k < repeat; k++) {
+
+        double start = omp_get_wtime(), seconds = 0, work = 0; do work += benchmark.run(), seconds = omp_get_wtime() - start; while (seconds < duration);
+
+        if (work / seconds > result.value) result.value = work / seconds, result.seconds = seconds, result.work = work;
+    }
+
+    return result;
+}
+
+void write_results(const std::vector<Result>& results, const std::string& filename) {
+    std::ofstream file(filename); file << std::setprecision(10) << "{\"threads\": " << nthread << ", \"results\": [\n";
+
+    for (size_t k = 0; k < results.size(); k++) {
+        const Result& result = results.at(k); file << "  {\"name\": \"" << result.name << "\", \"unit\": \"" << result.unit << "\", \"value\": " << result.value << ", \"seconds\": " << result.seconds << ", \"work\": " << result.work << "}" << (k + 1 < results.size() ? ",\n" : "\n");
+    } file << "]}\n";
+
+    if (!file) throw std::runtime_error("COULD NOT WRITE THE RESULTS FILE");
+}
+
+std::unordered_map<std::string, double> read_results(const std::string& filename) {
+    std::ifstream file(filename); std::unordered_map<std::string, double> results; std::string line;
+
+    if (!file) throw std::runtime_error("COULD NOT OPEN THE BASELINE FILE");
+
+    while (std::getline(file, line)) {
+
+        size_t name = line.find("\"name\": \""), value = line.find("\"value\": "); if (name == std::string::npos || value == std::string::npos) continue;
+
+        results[line.substr(name + 9, line.find('"', name + 9) - name - 9)] = std::stod(line.substr(value + 9));
+    }
+
+    return results;
+}
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser program("Benchmark", "1.0", argparse::default_arguments::none);
+
+    program.add_argument("-a", "--all"      ).help("-- Also run the slow benchmarks, like the Lucas-Lehmer test of a six digit exponent."                   ).default_value(false).implicit_value(true);
+    program.add_argument("-c", "--compare"  ).help("-- Compare with a baseline written by --output and fail if any benchmark got slower than the tolerance.");
+    program.add_argument("-f", "--filter"   ).help("-- Run only the benchmarks whose name contains this string."                                            ).default_value("");
+    program.add_argument("-l", "--list"     ).help("-- List the benchmark names without running them."                                                      ).default_value(false).implicit_value(true);
+    program.add_argument("-m", "--mpfr"     ).help("-- Number of bits of precision for the mpreal fractal benchmarks."                                      ).default_value(128U).scan<'i', unsigned int>();
+    program.add_argument("-n", "--nthread"  ).help("-- Number of threads for the fractal and Mersenne benchmarks."                                          ).default_value(1U).scan<'i', unsigned int>();
+    program.add_argument("-o", "--output"   ).help("-- Write the results as JSON to this file."                                                             );
+    program.add_argument("-r", "--repeat"   ).help("-- Number of runs of every benchmark, the fastest one is reported."                                     ).default_value(3U).scan<'i', unsigned int>();
+    program.add_argument("-s", "--seconds"  ).help("-- Minimum duration of every run, short kernels are called repeatedly until it is reached."             ).default_value(0.1).scan<'g', double>();
+    program.add_argument("-t", "--tolerance").help("-- Allowed slowdown against the baseline in percent."                                                   ).default_value(10.0).scan<'g', double>();
+    program.add_argument("-h", "--help"     ).help("-- Show this help message."                                                                             ).default_value(false).implicit_value(true);
+
+    try {program.parse_args(argc, argv);} catch (const std::runtime_error& error) {
+        if (!program.get<bool>("-h")) std::cerr << error.what() << std::endl, exit(EXIT_FAILURE);
+    } if (program.get<bool>("-h")) std::cout << program.help().str(), exit(EXIT_SUCCESS);
+
+    nthread = program.get<unsigned int>("--nthread"); omp_set_num_threads(nthread); std::unordered_map<std::string, double> baseline; std::vector<Result> results; unsigned int regressions = 0;
+
+    #pragma omp parallel for num_threads(nthread)
+    for (unsigned int i = 0; i < nthread; i++) mpfr::mpreal::set_default_prec(program.get<unsigned int>("--mpfr"));
+
+    mpfr::mpreal::set_default_prec(program.get<unsigned int>("--mpfr"));
+
+    if (program.is_used("--compare")) baseline = read_results(program.get("--compare"));
+
+    for (const Benchmark& benchmark : benchmarks(program.get<bool>("--all"))) {
+
+        if (benchmark.name.find(program.get("--filter")) == std::string::npos) continue;
+
+        if (program.get<bool>("--list")) {std::cout << benchmark.name << std::endl; continue;}
+
+        Result result = measure(benchmark, program.get<unsigned int>("--repeat"), program.get<double>("--seconds")); results.push_back(result);
+
+        std::cout << std::left << std::setw(40) << result.name << std::right << std::setw(14) << std::setprecision(4) << std::scientific << result.value << " " << std::setw(12) << std::left << result.unit;
+
+        if (baseline.count(result.name)) {
+
+            double change = 100 * (result.value / baseline.at(result.name) - 1); bool regression = change < -program.get<double>("--tolerance"); regressions += regression;
+
+            std::cout << std::right << std::fixed << std::setprecision(1) << std::setw(8) << std::showpos << change << "%" << std::noshowpos << (regression ? " REGRESSION" : "");
+        }
+
+        std::cout << std::endl;
+    }
+
+    if (program.is_used("--output")) write_results(results, program.get("--output"));
+
+    if (program.is_used("--compare")) std::cout << regressions << " OF " << results.size() << " BENCHMARKS REGRESSED" << std::endl;
+
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
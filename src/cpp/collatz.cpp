@@ -1,34 +1,28 @@
 #include <argparse.hpp>
-#include      <gmpxx.h>
-
-mpz_class f(const mpz_class& n) {
-    return n % mpz_class(2) == 0 ? mpz_class(n / 2) : 3 * n + 1;
-}
-
-std::vector<mpz_class> get_series(mpz_class n) {
-    std::vector<mpz_class> series = {n}; while (n != 1) n = f(n), series.push_back(n); return series;
-}
+#include    <collatz.h>
 
 int main(int argc, char** argv) {
     argparse::ArgumentParser program("Mersenne", "1.0", argparse::default_arguments::none);
 
-    program.add_argument("-l", "--length").help("-- Calculate the length of the series for the given number."   );
-    program.add_argument("-m", "--maximum").help("-- Print the highest number in a series for the given number.");
-    program.add_argument("-s", "--series").help("-- Print the series for the given number."                     );
-    program.add_argument("-h", "--help"  ).help("-- Show this help message."                                    ).default_value(false).implicit_value(true);
+    program.add_argument("-l", "--length"   ).help("-- Calculate the length of the series for the given number."                                               );
+    program.add_argument("-m", "--maximum"  ).help("-- Print the highest number in a series for the given number."                                             );
+    program.add_argument("-n", "--nthread"  ).help("-- Number of threads for the range sweep."                                                                 ).default_value(1U).scan<'i', unsigned int>();
+    program.add_argument("-r", "--range"    ).help("-- Sweep every starting value in this inclusive range of unsigned 64-bit numbers."                         ).nargs(2);
+    program.add_argument("-s", "--series"   ).help("-- Print the series for the given number."                                                                 );
+    program.add_argument("-t", "--statistic").help("-- Statistic of the range sweep, length or maximum records as they are found, or a histogram of the lengths.").default_value("length");
+    program.add_argument("-h", "--help"     ).help("-- Show this help message."                                                                                ).default_value(false).implicit_value(true);
 
     try {program.parse_args(argc, argv);} catch (const std::runtime_error& error) {
         if (!program.get<bool>("-h")) std::cerr << error.what() << std::endl, exit(EXIT_FAILURE);
     } if (program.get<bool>("-h")) std::cout << program.help().str(), exit(EXIT_SUCCESS);
 
-    std::vector<mpz_class> series;
-
-    if (program.is_used("-l")) series = get_series(mpz_class(program.get("-l")));
-    if (program.is_used("-m")) series = get_series(mpz_class(program.get("-m")));
-    if (program.is_used("-s")) series = get_series(mpz_class(program.get("-s")));
+    omp_set_num_threads(program.get<unsigned int>("--nthread"));
 
+    if (program.is_used("-r")) {
+        std::vector<std::string> range = program.get<std::vector<std::string>>("-r"); sweep(std::stoull(range.at(0)), std::stoull(range.at(1)), program.get("-t"));
+    }
 
-    if (program.is_used("-l")) std::cout << series.size() << std::endl;
-    if (program.is_used("-m")) std::cout << *std::max_element(series.begin(), series.end()) << std::endl;
-    if (program.is_used("-s")) for (const mpz_class& i : series) std::cout << i << std::endl;
+    if (program.is_used("-l")) std::cout << series_length(mpz_class(program.get("-l"))) << std::endl;
+    if (program.is_used("-m")) std::cout << series_maximum(mpz_class(program.get("-m"))) << std::endl;
+    if (program.is_used("-s")) write_series(mpz_class(program.get("-s")), std::cout);
 }
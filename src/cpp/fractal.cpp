@@ -1,243 +1,74 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 
 #include      <argparse.hpp>
-#include          <mpreal.h>
+#include         <fractal.h>
 #include <stb_image_write.h>
-#include            <random>
-
-unsigned int nthread = 1;
-
-template <typename T>
-struct FractalFunctions {
-    std::unordered_map<std::string, std::function<std::tuple<std::complex<T>, std::complex<T>>(const std::complex<T>&, const std::complex<T>&, const std::complex<T>&, const std::complex<T>&)>> content = {
-        {"buffalo", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            std::complex<T> abs_z = {abs(z.real()), abs(z.imag())}; return std::make_tuple(abs_z * abs_z - abs_z + p, z);
-        }},
-        {"burningship", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            std::complex<T> abs_z = {abs(z.real()), abs(z.imag())}; return std::make_tuple(abs_z * abs_z + p, z);
-        }},
-        {"julia", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            return std::make_tuple(z * z + c, z);
-        }},
-        {"mandelbrot", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            return std::make_tuple(z * z + p, z);
-        }},
-        {"manowar", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            return std::make_tuple(z * z + zp + p, z);
-        }},
-        {"phoenix", [](const std::complex<T>& p, const std::complex<T>& z, const std::complex<T>& zp, const std::complex<T>& c) {
-            return std::make_tuple(z * z - T(0.5) * zp + T(0.5667), z);
-        }}
-    };
-};
-
-template <typename T>
-struct FractalInitialConditions {
-    std::unordered_map<std::string, std::function<std::tuple<std::complex<T>, std::complex<T>, std::complex<T>>(const std::complex<T>&, const std::complex<T>&)>> content = {
-        {"buffalo",     [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
-        {"burningship", [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
-        {"julia",       [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, p, T(0));}},
-        {"mandelbrot",  [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, T(0), T(0));}},
-        {"manowar",     [](const std::complex<T>& p, const std::complex<T>& c) {return std::make_tuple(p, p, p);}},
-        {"phoenix",     [](const std::complex<T>& p, const std::complex<T>& c) {std::complex t = {-p.imag(), p.real()}; return std::make_tuple(p, t, c);}}
-    };
-};
-
-template <typename T>
-struct TrapFunctions {
-    std::vector<std::function<T(const std::complex<T>&)>> content = {
-        [](const std::complex<T>& p) {return std::norm(p);},
-        [](const std::complex<T>& p) {return std::min(abs(p.real()), abs(p.imag()));},
-        [](const std::complex<T>& p) {return std::min(abs(p.real() - p.imag()), abs(p.real() + p.imag())) / sqrt(2);},
-        [](const std::complex<T>& p) {return abs(std::norm(p) - 1.0);},
-        [](const std::complex<T>& p) {return std::min(std::norm(p), abs(std::norm(p) - 1.0));}
-    }; 
-};
-
-struct Image {
-    std::vector<unsigned char> data; unsigned int width, height;
-};
-
-struct Fractal {
-    std::string name; double parameter;
-};
-
-struct Density {
-    double bailout_radius; unsigned int max_iterations, samples, seed; bool enable_smooth;
-};
-
-struct Escape {
-    double bailout_radius; unsigned int max_iterations; bool enable_smooth;
-};
-
-struct Trap {
-    double bailout_radius; unsigned int max_iterations, trap_index; bool fill_background;
-};
 
-struct Linear {
-    std::array<unsigned char, 3> from, to;
-};
+#include  <future>
+#include <sstream>
 
-struct Periodic {
-    std::array<double, 3> amplitude; std::array<double, 3> phase;
-};
-
-struct Solid {
-    std::array<unsigned char, 3> color;
-};
+void add_arguments(argparse::ArgumentParser& program) {
+    program.add_argument("-a", "--metropolis").help("-- Metropolis-Hastings sampling for the density algorithm with number of chains, warm-up steps per chain and mutation size relative to the view.").nargs(3).default_value(std::vector<std::string>{"64", "1000", "0.02"});
+    program.add_argument("-b", "--boundary").help("-- Boundary tracing for the escape algorithm with minimum rectangle size and verify boolean, escaped regions are filled only without smoothing.").nargs(2).default_value(std::vector<std::string>{"8", "0"});
+    program.add_argument("-c", "--center").help("-- Center of the image.").nargs(2).default_value(std::vector<std::string>{"-0.75", "0"});
+    program.add_argument("-d", "--density").help("-- Density algorithm with number of iterations, bailout radius, number of samples and seed.").nargs(4).default_value(std::vector<std::string>{"80", "10", "1e7", "1"});
+    program.add_argument("-e", "--escape").help("-- Escape algorithm with number of iterations, bailout radius and smooth boolean.").nargs(3).default_value(std::vector<std::string>{"80", "10", "1"});
+    program.add_argument("-f", "--fractal").help("-- Name of the fractal to generate and its parameter if needed.").nargs(3).default_value(std::vector<std::string>{"mandelbrot", "0"});
+    program.add_argument("-g", "--batch").help("-- Render every line of the file, or the standard input if '-', as a separate set of arguments while writing the previous image.").default_value("-");
+    program.add_argument("-h", "--help").help("-- This help message.").default_value(false).implicit_value(true);
+    program.add_argument("-i", "--interior").help("-- Detect interior points by bulb tests and orbit periodicity and report the skipped iterations.").default_value(false).implicit_value(true);
+    program.add_argument("-j", "--report").help("-- Write a JSON report with per-tile time and iterations and per-thread busy and idle time next to the output as <output>.json.").default_value(false).implicit_value(true);
+    program.add_argument("-k", "--animate").help("-- Animation with number of frames and the center and zoom of the last frame, the output filename gets the frame index.").nargs(4).default_value(std::vector<std::string>{"2", "-0.75", "0", "1.1"});
+    program.add_argument("-l", "--linear").help("-- Linear coloring algorithm with red, green and blue parameters for start and end of linear interpolation.").nargs(6).default_value(std::vector<unsigned int>{0, 0, 0, 255, 255, 255}).scan<'i', unsigned int>();
+    program.add_argument("-m", "--mpfr").help("-- Number of bits of precision, double-double up to 106 and quad-double up to 212 bits before falling back to MPFR.").default_value(64U).scan<'i', unsigned int>();
+    program.add_argument("-n", "--nthread").help("-- Number of threads to use.").default_value(1U).scan<'i', unsigned int>();
+    program.add_argument("-o", "--output").help("-- Output filename.").default_value("fractal.png");
+    program.add_argument("-w", "--strip").help("-- Render strips of this many rows straight into a resumable PPM output file.").default_value(256U).scan<'i', unsigned int>();
+    program.add_argument("-x", "--field").help("-- Also write the raw escape, trap or density field next to the output as <output>.field.").default_value(false).implicit_value(true);
+    program.add_argument("-y", "--recolor").help("-- Color a field written by --field instead of computing the fractal.").default_value("fractal.png.field");
+    program.add_argument("-u", "--perturbation").help("-- Perturbation deep zoom for the escape algorithm with series approximation boolean.").nargs(1).default_value(std::vector<std::string>{"1"});
+    program.add_argument("-p", "--periodic").help("-- Periodic coloring algorithm with 6 parameters.").nargs(6).default_value(std::vector<double>{31.93, 6.26, 30.38, 5.86, 11.08, 0.81}).scan<'g', double>();
+    program.add_argument("-q", "--equalize").help("-- Histogram equalization of the field before coloring.").default_value(false).implicit_value(true);
+    program.add_argument("-r", "--resolution").help("-- Resolution of the image.").nargs(2).default_value(std::vector<unsigned int>{1920U, 1080U}).scan<'i', unsigned int>();
+    program.add_argument("-s", "--solid").help("-- Solid coloring algorithm with red, green and blue parameters.").nargs(3).default_value(std::vector<unsigned int>{255, 255, 255}).scan<'i', unsigned int>();
+    program.add_argument("-t", "--trap").help("-- Trap algorithm with number of iterations, bailout radius, trap index and fill boolean.").nargs(4).default_value(std::vector<std::string>{"80", "100", "2", "0"});
+    program.add_argument("-z", "--zoom").help("-- Zoom of the image.").default_value("1.1");
+}
 
-template <typename T, class C>
-void draw_density(Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Density& density_algorithm, const C& color_algorithm) {
-    auto fractal_function = FractalFunctions<T>().content.at(fractal.name); auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name);
+unsigned int zoom_precision(const argparse::ArgumentParser& program, unsigned int height) {
+    mpfr::mpreal zoom = std::max(mpfr::mpreal(program.get("--zoom")), program.is_used("--animate") ? mpfr::mpreal(program.get<std::vector<std::string>>("--animate").at(3)) : mpfr::mpreal(0));
 
-    std::uniform_real_distribution<double> uniform_real(-3.9, 3.9), uniform_imag(-2.5, 2.5); std::mt19937 mt(density_algorithm.seed);
-    std::vector<unsigned int> data(image.width * image.height, 0); std::vector<std::vector<unsigned int>> thread_data(nthread, data);
+    return (unsigned int)std::max(0.0, log2(zoom * height).toDouble()) + 64;
+}
 
-    std::vector<std::complex<T>> ps(density_algorithm.samples); std::generate(ps.begin(), ps.end(), [&]() {return std::complex<double>(uniform_real(mt), uniform_imag(mt));});
+std::vector<std::vector<std::string>> animation_views(const argparse::ArgumentParser& program) {
+    std::vector<std::string> center = program.get<std::vector<std::string>>("--center"), animation = program.get<std::vector<std::string>>("--animate");
 
-    #pragma omp parallel for num_threads(nthread)
-    for (const std::complex<T>& p : ps) {
+    if (!program.is_used("--animate")) return {{center.at(0), center.at(1), program.get("--zoom")}};
 
-        std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter)), z, zp;
+    mpfr::mpreal::set_default_prec(std::max(program.get<unsigned int>("--mpfr"), zoom_precision(program, program.get<std::vector<unsigned int>>("--resolution").at(1))));
 
-        std::tie(std::ignore, z, zp) = fractal_ic_function(p, parameter); std::vector<std::complex<T>> orbit;
+    mpfr::mpreal r0 = center.at(0), i0 = center.at(1), z0 = program.get("--zoom"), r1 = animation.at(1), i1 = animation.at(2), z1 = animation.at(3); std::vector<std::vector<std::string>> views; int frames = std::stoi(animation.at(0));
 
-        for (int n = 0; n < density_algorithm.max_iterations; n++) {
-            std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > density_algorithm.bailout_radius * density_algorithm.bailout_radius) break; orbit.push_back(z);
-        }
+    if (frames < 2) throw std::runtime_error("ANIMATION NEEDS AT LEAST TWO FRAMES");
 
-        if (std::norm(z) > density_algorithm.bailout_radius * density_algorithm.bailout_radius) for (const std::complex<T>& o : orbit) {
+    for (int k = 0; k < frames; k++) {
 
-            int i = (int)round(((o.imag() + center.imag()) * image.height * zoom + 1.5 * image.height) / 3.0 - 0.5);
-            int j = (int)round(((o.real() - center.real()) * image.height * zoom + 1.5 * image.width)  / 3.0 - 0.5);
+        mpfr::mpreal t = mpfr::mpreal(k) / (frames - 1), z = z0 * pow(z1 / z0, t), w = z0 == z1 ? 1 - t : (1 / z - 1 / z1) / (1 / z0 - 1 / z1);
 
-            if (i < 0 || j < 0 || i >= image.height || j >= image.width) continue; thread_data.at(0).at(i * image.width + j)++;
-        }
+        views.push_back({(r1 + (r0 - r1) * w).toString(), (i1 + (i0 - i1) * w).toString(), z.toString()});
     }
 
-    for (int i = 0; i < nthread; i++) for (size_t j = 0; j < data.size(); j++) data.at(j) += thread_data.at(i).at(j);
-
-    unsigned int max = *std::max_element(data.begin(), data.end());
-
-    #pragma omp parallel for collapse(2) num_threads(nthread)
-    for (int i = 0; i < image.height; i++) for (int j = 0; j < image.width; j++) {
-        if constexpr (std::is_same<C, Linear>()) {
-            image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((double)color_algorithm.from.at(0) + (double)data.at(i * image.width + j) / max * (color_algorithm.to.at(0) - color_algorithm.from.at(0)));
-            image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((double)color_algorithm.from.at(1) + (double)data.at(i * image.width + j) / max * (color_algorithm.to.at(1) - color_algorithm.from.at(1)));
-            image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((double)color_algorithm.from.at(2) + (double)data.at(i * image.width + j) / max * (color_algorithm.to.at(2) - color_algorithm.from.at(2)));
-        } else if constexpr (std::is_same<C, Periodic>()) {
-            image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((sin(color_algorithm.amplitude.at(0) * (double)data.at(i * image.width + j) / max + color_algorithm.phase.at(0)) + 1) * 127.5);
-            image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((sin(color_algorithm.amplitude.at(1) * (double)data.at(i * image.width + j) / max + color_algorithm.phase.at(1)) + 1) * 127.5);
-            image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((sin(color_algorithm.amplitude.at(2) * (double)data.at(i * image.width + j) / max + color_algorithm.phase.at(2)) + 1) * 127.5);
-        } else if constexpr (std::is_same<C, Solid>()) {
-            if (data.at(i * image.width + j)) image.data.at(3 * i * image.width + 3 * j + 0) = color_algorithm.color.at(0);
-            if (data.at(i * image.width + j)) image.data.at(3 * i * image.width + 3 * j + 1) = color_algorithm.color.at(1);
-            if (data.at(i * image.width + j)) image.data.at(3 * i * image.width + 3 * j + 2) = color_algorithm.color.at(2);
-        } else throw std::runtime_error("COLORING ALGORITHM FOR THIS GENERATION ALGORITHM NOT SUPPORTED");
-    }
+    return views;
 }
 
-template <typename T, class C>
-void draw_escape(Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Escape& escape_algorithm, const C& color_algorithm) {
-    auto fractal_function = FractalFunctions<T>().content.at(fractal.name); auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name);
-
-    #pragma omp parallel for collapse(2) num_threads(nthread)
-    for (int i = 0; i < image.height; i++) for (int j = 0; j < image.width; j++) {
-
-        std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter));
-
-        T im = -center.imag() + (3.0 * (i + 0.5) - 1.5 * image.height) / zoom / image.height;
-        T re =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.height;
-
-        auto [p, z, zp] = fractal_ic_function(std::complex<T>{re, im}, parameter); int n; T v;
+std::string frame_output(const std::string& output, int frame) {
+    std::string index = std::to_string(frame); index.insert(0, 5 - std::min<size_t>(5, index.size()), '0'); size_t dot = output.rfind('.');
 
-        for (n = 0; n < escape_algorithm.max_iterations; n++) {
-            std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > escape_algorithm.bailout_radius * escape_algorithm.bailout_radius) break;
-        }
-
-        if (v = n; n < escape_algorithm.max_iterations && escape_algorithm.enable_smooth) v -= log2(0.5 * log(std::norm(z)));
-
-        if (n < escape_algorithm.max_iterations) {
-            if constexpr (std::is_same<C, Linear>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((double)color_algorithm.from.at(0) + v / escape_algorithm.max_iterations * (color_algorithm.to.at(0) - color_algorithm.from.at(0)));
-                image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((double)color_algorithm.from.at(1) + v / escape_algorithm.max_iterations * (color_algorithm.to.at(1) - color_algorithm.from.at(1)));
-                image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((double)color_algorithm.from.at(2) + v / escape_algorithm.max_iterations * (color_algorithm.to.at(2) - color_algorithm.from.at(2)));
-            } else if constexpr (std::is_same<C, Periodic>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((sin(color_algorithm.amplitude.at(0) * v / escape_algorithm.max_iterations + color_algorithm.phase.at(0)) + 1) * 127.5);
-                image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((sin(color_algorithm.amplitude.at(1) * v / escape_algorithm.max_iterations + color_algorithm.phase.at(1)) + 1) * 127.5);
-                image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((sin(color_algorithm.amplitude.at(2) * v / escape_algorithm.max_iterations + color_algorithm.phase.at(2)) + 1) * 127.5);
-            } else if constexpr (std::is_same<C, Solid>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = color_algorithm.color.at(0);
-                image.data.at(3 * i * image.width + 3 * j + 1) = color_algorithm.color.at(1);
-                image.data.at(3 * i * image.width + 3 * j + 2) = color_algorithm.color.at(2);
-            } else throw std::runtime_error("COLORING ALGORITHM FOR THIS GENERATION ALGORITHM NOT SUPPORTED");
-        }
-    }
-}
-
-template <typename T, class C>
-void draw_trap(Image& image, const Fractal& fractal, const std::complex<T>& center, T zoom, const Trap& trap_algorithm, const C& color_algorithm) {
-    auto fractal_function    = FractalFunctions<T>()        .content.at(fractal.name             );
-    auto fractal_ic_function = FractalInitialConditions<T>().content.at(fractal.name             );
-    auto trap_function       = TrapFunctions<T>()           .content.at(trap_algorithm.trap_index);
-
-    #pragma omp parallel for collapse(2) num_threads(nthread)
-    for (int i = 0; i < image.height; i++) for (int j = 0; j < image.width; j++) {
-
-        std::complex<T> parameter = exp(std::complex<T>{0, 1} * T(fractal.parameter));
-
-        T im = -center.imag() + (3.0 * (i + 0.5) - 1.5 * image.height) / zoom / image.height;
-        T re =  center.real() + (3.0 * (j + 0.5) - 1.5 * image.width)  / zoom / image.height;
-
-        auto [p, z, zp] = fractal_ic_function(std::complex<T>{re, im}, parameter); std::vector<std::complex<T>> orbit;
-
-        for(int n = 0; n < trap_algorithm.max_iterations; n++) {
-            std::tie(z, zp) = fractal_function(p, z, zp, parameter); if (std::norm(z) > trap_algorithm.bailout_radius * trap_algorithm.bailout_radius) break; orbit.push_back(z);
-        }
-
-        if (!trap_algorithm.fill_background || std::norm(z) > trap_algorithm.bailout_radius * trap_algorithm.bailout_radius) {
-
-            T v = trap_function(*std::min_element(orbit.begin(), orbit.end(), [&](const std::complex<T>& a, const std::complex<T>& b) {return trap_function(a) < trap_function(b);}));
-            
-            if constexpr (std::is_same<C, Linear>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((double)color_algorithm.from.at(0) + 1 / (1 + 5 * v) * (color_algorithm.to.at(0) - color_algorithm.from.at(0)));
-                image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((double)color_algorithm.from.at(1) + 1 / (1 + 5 * v) * (color_algorithm.to.at(1) - color_algorithm.from.at(1)));
-                image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((double)color_algorithm.from.at(2) + 1 / (1 + 5 * v) * (color_algorithm.to.at(2) - color_algorithm.from.at(2)));
-            } else if constexpr (std::is_same<C, Periodic>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = (unsigned char)((sin(color_algorithm.amplitude.at(0) * 0.03 * log(v) + color_algorithm.phase.at(0)) + 1) * 127.5);
-                image.data.at(3 * i * image.width + 3 * j + 1) = (unsigned char)((sin(color_algorithm.amplitude.at(1) * 0.03 * log(v) + color_algorithm.phase.at(1)) + 1) * 127.5);
-                image.data.at(3 * i * image.width + 3 * j + 2) = (unsigned char)((sin(color_algorithm.amplitude.at(2) * 0.03 * log(v) + color_algorithm.phase.at(2)) + 1) * 127.5);
-            } else if constexpr (std::is_same<C, Solid>()) {
-                image.data.at(3 * i * image.width + 3 * j + 0) = color_algorithm.color.at(0);
-                image.data.at(3 * i * image.width + 3 * j + 1) = color_algorithm.color.at(1);
-                image.data.at(3 * i * image.width + 3 * j + 2) = color_algorithm.color.at(2);
-            } else throw std::runtime_error("COLORING ALGORITHM FOR THIS GENERATION ALGORITHM NOT SUPPORTED");
-        }
-    }
+    return dot == std::string::npos ? output + "_" + index : output.substr(0, dot) + "_" + index + output.substr(dot);
 }
 
-int main(int argc, char** argv) {
-    argparse::ArgumentParser program("Fractal", "1.0", argparse::default_arguments::none);
-
-    program.add_argument("-c", "--center").help("-- Center of the image.").nargs(2).default_value(std::vector<std::string>{"-0.75", "0"});
-    program.add_argument("-d", "--density").help("-- Density algorithm with number of iterations, bailout radius, number of samples and seed.").nargs(4).default_value(std::vector<std::string>{"80", "10", "1e7", "1"});
-    program.add_argument("-e", "--escape").help("-- Escape algorithm with number of iterations, bailout radius and smooth boolean.").nargs(3).default_value(std::vector<std::string>{"80", "10", "1"});
-    program.add_argument("-f", "--fractal").help("-- Name of the fractal to generate and its parameter if needed.").nargs(3).default_value(std::vector<std::string>{"mandelbrot", "0"});
-    program.add_argument("-h", "--help").help("-- This help message.").default_value(false).implicit_value(true);
-    program.add_argument("-l", "--linear").help("-- Linear coloring algorithm with red, green and blue parameters for start and end of linear interpolation.").nargs(6).default_value(std::vector<unsigned int>{0, 0, 0, 255, 255, 255}).scan<'i', unsigned int>();
-    program.add_argument("-m", "--mpfr").help("-- Number of bits to represent a MPFR real number.").default_value(64U).scan<'i', unsigned int>();
-    program.add_argument("-n", "--nthread").help("-- Number of threads to use.").default_value(1U).scan<'i', unsigned int>();
-    program.add_argument("-o", "--output").help("-- Output filename.").default_value("fractal.png");
-    program.add_argument("-p", "--periodic").help("-- Periodic coloring algorithm with 6 parameters.").nargs(6).default_value(std::vector<double>{31.93, 6.26, 30.38, 5.86, 11.08, 0.81}).scan<'g', double>();
-    program.add_argument("-r", "--resolution").help("-- Resolution of the image.").nargs(2).default_value(std::vector<unsigned int>{1920U, 1080U}).scan<'i', unsigned int>();
-    program.add_argument("-s", "--solid").help("-- Solid coloring algorithm with red, green and blue parameters.").nargs(3).default_value(std::vector<unsigned int>{255, 255, 255}).scan<'i', unsigned int>();
-    program.add_argument("-t", "--trap").help("-- Trap algorithm with number of iterations, bailout radius, trap index and fill boolean.").nargs(4).default_value(std::vector<std::string>{"80", "100", "2", "0"});
-    program.add_argument("-z", "--zoom").help("-- Zoom of the image.").default_value("1.1");
-
-    try {program.parse_args(argc, argv);} catch (const std::runtime_error& error) {
-        if (!program.get<bool>("-h")) std::cerr << error.what() << std::endl, exit(EXIT_FAILURE);
-    } if (program.get<bool>("-h")) std::cout << program.help().str(), exit(EXIT_SUCCESS);
-
+void render(const argparse::ArgumentParser& program, Image& image, const std::vector<std::string>& view, const std::string& output, const std::string& signature) {
     if (program.is_used("--escape") + program.is_used("--trap") + program.is_used("--density") > 1) {
         throw std::runtime_error("YOU CAN USE ONLY ONE ALGORITHM AT A TIME");
     }
@@ -246,13 +77,13 @@ int main(int argc, char** argv) {
         throw std::runtime_error("YOU CAN USE ONLY ONE COLORING AT A TIME");
     }
 
-    std::complex<mpfr::mpreal> center; nthread = program.get<unsigned int>("--nthread");
+    std::complex<mpfr::mpreal> center; std::string zoom = view.at(2); nthread = program.get<unsigned int>("--nthread"); skipped_iterations = computed_pixels = mismatched_pixels = 0; tile_statistics.clear(), thread_busy.assign(nthread, 0), tile_wall = 0;
 
-    Image image; Fractal fractal; Density density_algorithm; Escape escape_algorithm; Trap trap_algorithm; Linear linear_algorithm; Periodic periodic_algorithm; Solid solid_algorithm;
+    Fractal fractal; Density density_algorithm; Escape escape_algorithm; Perturbation perturbation_algorithm; Trap trap_algorithm; Linear linear_algorithm; Periodic periodic_algorithm; Solid solid_algorithm;
 
     image.width  = program.get<std::vector<unsigned int>>("--resolution").at(0 );
     image.height = program.get<std::vector<unsigned int>>("--resolution").at(1 );
-    image.data   = std::vector<unsigned char>(3 * image.width * image.height, 0);
+    image.top = 0, image.frame_height = image.height; if (!program.is_used("--strip")) image.data.assign(3 * image.width * image.height, 0);
 
     fractal.name = program.get<std::vector<std::string>>("--fractal").at(0), fractal.parameter = std::stod(program.get<std::vector<std::string>>("--fractal").at(1));
 
@@ -261,14 +92,27 @@ int main(int argc, char** argv) {
     density_algorithm.samples        = std::stod(program.get<std::vector<std::string>>("--density").at(2));
     density_algorithm.seed           = std::stoi(program.get<std::vector<std::string>>("--density").at(3));
 
+    density_algorithm.enable_metropolis = program.is_used("--metropolis");
+    density_algorithm.chains            = std::stoi(program.get<std::vector<std::string>>("--metropolis").at(0));
+    density_algorithm.warmup            = std::stod(program.get<std::vector<std::string>>("--metropolis").at(1));
+    density_algorithm.mutation          = std::stod(program.get<std::vector<std::string>>("--metropolis").at(2));
+
     escape_algorithm.max_iterations = std::stoi(program.get<std::vector<std::string>>("--escape").at(0));
     escape_algorithm.bailout_radius = std::stod(program.get<std::vector<std::string>>("--escape").at(1));
     escape_algorithm.enable_smooth  = std::stoi(program.get<std::vector<std::string>>("--escape").at(2));
+    escape_algorithm.enable_interior = program.get<bool>("--interior");
+
+    escape_algorithm.enable_subdivision = program.is_used("--boundary");
+    escape_algorithm.subdivision_size   = std::stoi(program.get<std::vector<std::string>>("--boundary").at(0));
+    escape_algorithm.verify_subdivision = std::stoi(program.get<std::vector<std::string>>("--boundary").at(1));
+
+    perturbation_algorithm.enable_series = std::stoi(program.get<std::vector<std::string>>("--perturbation").at(0));
 
     trap_algorithm.max_iterations  = std::stoi(program.get<std::vector<std::string>>("--trap").at(0));
     trap_algorithm.bailout_radius  = std::stod(program.get<std::vector<std::string>>("--trap").at(1));
     trap_algorithm.trap_index      = std::stoi(program.get<std::vector<std::string>>("--trap").at(2));
     trap_algorithm.fill_background = std::stoi(program.get<std::vector<std::string>>("--trap").at(3));
+    trap_algorithm.enable_interior = program.get<bool>("--interior");
 
     linear_algorithm.from.at(0) = program.get<std::vector<unsigned int>>("--linear").at(0);
     linear_algorithm.from.at(1) = program.get<std::vector<unsigned int>>("--linear").at(1);
@@ -288,46 +132,125 @@ int main(int argc, char** argv) {
     solid_algorithm.color.at(1) = program.get<std::vector<unsigned int>>("--solid").at(1);
     solid_algorithm.color.at(2) = program.get<std::vector<unsigned int>>("--solid").at(2);
 
-    center.real(mpfr::mpreal(program.get<std::vector<std::string>>("--center").at(0)));
-    center.imag(mpfr::mpreal(program.get<std::vector<std::string>>("--center").at(1)));
+    if (program.is_used("--perturbation") && (program.is_used("--trap") || program.is_used("--density"))) {
+        throw std::runtime_error("PERTURBATION IS SUPPORTED ONLY FOR THE ESCAPE ALGORITHM");
+    }
+
+    if (program.is_used("--perturbation") && program.get<bool>("--interior")) {
+        throw std::runtime_error("PERTURBATION DOES NOT SUPPORT INTERIOR DETECTION");
+    }
+
+    if (program.is_used("--strip") && program.is_used("--density")) {
+        throw std::runtime_error("STRIP RENDERING IS NOT SUPPORTED FOR THE DENSITY ALGORITHM");
+    }
+
+    if (program.is_used("--strip") && (program.get<bool>("--field") || program.get<bool>("--equalize") || program.is_used("--recolor"))) {
+        throw std::runtime_error("STRIP RENDERING DOES NOT SUPPORT FIELDS, RECOLORING OR EQUALIZATION");
+    }
+
+    unsigned int precision = program.get<unsigned int>("--mpfr");
+
+    if (program.is_used("--perturbation")) precision = std::max(precision, zoom_precision(program, image.height));
 
     #pragma omp parallel for num_threads(nthread)
-    for (int i = 0; i < nthread; i++) mpfr::mpreal::set_default_prec(nthread);
-
-    if (program.is_used("--linear")) {
-        if (program.is_used("--density")) {
-            if (program.is_used("--mpfr")) draw_density<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), density_algorithm, linear_algorithm);
-            else draw_density<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), density_algorithm, linear_algorithm);
-        } else if (program.is_used("--trap")) {
-            if (program.is_used("--mpfr")) draw_trap<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), trap_algorithm, linear_algorithm);
-            else draw_trap<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), trap_algorithm, linear_algorithm);
-        } else {
-            if (program.is_used("--mpfr")) draw_escape<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), escape_algorithm, linear_algorithm);
-            else draw_escape<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), escape_algorithm, linear_algorithm);
-        }
-    } else if (program.is_used("--solid")) {
-        if (program.is_used("--density")) {
-            if (program.is_used("--mpfr")) draw_density<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), density_algorithm, solid_algorithm);
-            else draw_density<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), density_algorithm, solid_algorithm);
-        } else if (program.is_used("--trap")) {
-            if (program.is_used("--mpfr")) draw_trap<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), trap_algorithm, solid_algorithm);
-            else draw_trap<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), trap_algorithm, solid_algorithm);
-        } else {
-            if (program.is_used("--mpfr")) draw_escape<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), escape_algorithm, solid_algorithm);
-            else draw_escape<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), escape_algorithm, solid_algorithm);
+    for (int i = 0; i < nthread; i++) mpfr::mpreal::set_default_prec(precision);
+
+    center.real(mpfr::mpreal(view.at(0))), center.imag(mpfr::mpreal(view.at(1)));
+
+    auto finish = [&](Field& field) {
+        if (program.get<bool>("--field")) write_field(field, output + ".field", signature);
+
+        if (program.get<bool>("--equalize")) equalize_field(field);
+
+        if (program.is_used("--linear")) paint_field(image, field, linear_algorithm);
+        else if (program.is_used("--solid")) paint_field(image, field, solid_algorithm);
+        else paint_field(image, field, periodic_algorithm);
+    };
+
+    auto draw = [&]() {
+        Field field; unsigned int bits = program.is_used("--mpfr") ? program.get<unsigned int>("--mpfr") : 53;
+
+        auto compute = [&]<typename T>(const std::complex<T>& center, const T& zoom) {
+            if (program.is_used("--density")) return density_field<T>(image, fractal, center, zoom, density_algorithm);
+            if (program.is_used("--trap")) return trap_field<T>(image, fractal, center, zoom, trap_algorithm);
+
+            return escape_field<T>(image, fractal, center, zoom, escape_algorithm);
+        };
+
+        if (program.is_used("--perturbation")) field = perturbation_field(image, fractal, center, zoom, escape_algorithm, perturbation_algorithm);
+        else if (bits <= 53) field = compute(std::complex<double>(center.real().toDouble(), center.imag().toDouble()), std::stod(zoom));
+        else if (bits <= 106) field = compute(std::complex<DoubleDouble>(multidouble_cast<DoubleDouble>(center.real()), multidouble_cast<DoubleDouble>(center.imag())), multidouble_cast<DoubleDouble>(zoom));
+        else if (bits <= 212) field = compute(std::complex<QuadDouble>(multidouble_cast<QuadDouble>(center.real()), multidouble_cast<QuadDouble>(center.imag())), multidouble_cast<QuadDouble>(zoom));
+        else field = compute(center, mpfr::mpreal(zoom));
+
+        finish(field);
+    };
+
+    if (program.is_used("--recolor")) {
+        Field field = read_field(program.get("--recolor")); image.width = field.width, image.height = image.frame_height = field.height, image.data.assign(3 * image.width * image.height, 0); return finish(field);
+    }
+
+    if (program.is_used("--strip")) draw_strips(image, output, signature, program.get<unsigned int>("--strip"), draw); else draw();
+
+    if (program.is_used("--boundary")) std::cout << "BOUNDARY TRACING COMPUTED " << computed_pixels << " OF " << image.width * image.height << " PIXELS" << std::endl;
+
+    if (program.is_used("--boundary") && escape_algorithm.verify_subdivision) std::cout << "BOUNDARY TRACING FILLED " << mismatched_pixels << " PIXELS INCORRECTLY" << std::endl;
+
+    if (program.get<bool>("--interior")) std::cout << "INTERIOR DETECTION SKIPPED " << skipped_iterations << " ITERATIONS" << std::endl;
+
+    if (program.get<bool>("--report")) write_report(output + ".json");
+}
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser program("Fractal", "1.0", argparse::default_arguments::none); add_arguments(program);
+
+    try {program.parse_args(argc, argv);} catch (const std::runtime_error& error) {
+        if (!program.get<bool>("-h")) std::cerr << error.what() << std::endl, exit(EXIT_FAILURE);
+    } if (program.get<bool>("-h")) std::cout << program.help().str(), exit(EXIT_SUCCESS);
+
+    std::array<Image, 2> images; std::future<void> writer; size_t frames = 0;
+
+    auto run = [&images, &writer, &frames](const argparse::ArgumentParser& job, const std::vector<std::string>& tokens) {
+        std::vector<std::vector<std::string>> views = animation_views(job); std::string arguments;
+
+        for (size_t k = 1; k < tokens.size(); k++) if (tokens.at(k) == "-n" || tokens.at(k) == "--nthread") k++; else arguments += " " + tokens.at(k);
+
+        for (size_t k = 0; k < views.size(); k++) {
+
+            std::string output = job.is_used("--animate") ? frame_output(job.get("--output"), k) : job.get("--output"), signature = views.at(k).at(0) + " " + views.at(k).at(1) + " " + views.at(k).at(2) + arguments;
+
+            Image& image = images.at(frames++ % 2); render(job, image, views.at(k), output, signature); if (writer.valid()) writer.get();
+
+            if (job.is_used("--strip")) continue;
+
+            writer = std::async(std::launch::async, [&image, output]() {stbi_write_png(output.c_str(), image.width, image.height, 3, image.data.data(), 3 * image.width);});
         }
-    } else {
-        if (program.is_used("--density")) {
-            if (program.is_used("--mpfr")) draw_density<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), density_algorithm, periodic_algorithm);
-            else draw_density<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), density_algorithm, periodic_algorithm);
-        } else if (program.is_used("--trap")) {
-            if (program.is_used("--mpfr")) draw_trap<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), trap_algorithm, periodic_algorithm);
-            else draw_trap<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), trap_algorithm, periodic_algorithm);
-        } else {
-            if (program.is_used("--mpfr")) draw_escape<mpfr::mpreal>(image, fractal, center, program.get("--zoom"), escape_algorithm, periodic_algorithm);
-            else draw_escape<double>(image, fractal, {center.real().toDouble(), center.imag().toDouble()}, std::stod(program.get("--zoom")), escape_algorithm, periodic_algorithm);
+    };
+
+    if (program.is_used("--batch")) {
+        std::ifstream file; if (program.get("--batch") != "-") file.open(program.get("--batch"));
+
+        std::istream& input = program.get("--batch") == "-" ? std::cin : file; std::string line;
+
+        if (!input) throw std::runtime_error("COULD NOT OPEN THE BATCH FILE");
+
+        for (size_t number = 1; std::getline(input, line); number++) {
+
+            std::istringstream stream(line); std::vector<std::string> tokens = {argv[0]}; for (std::string token; stream >> token;) tokens.push_back(token);
+
+            if (tokens.size() == 1 || tokens.at(1).front() == '#') continue;
+
+            argparse::ArgumentParser job("Fractal", "1.0", argparse::default_arguments::none); add_arguments(job);
+
+            try {job.parse_args(tokens);} catch (const std::runtime_error& error) {
+                std::cerr << "LINE " << number << ": " << error.what() << std::endl, exit(EXIT_FAILURE);
+            }
+
+            if (job.is_used("--batch")) throw std::runtime_error("BATCH FILES CAN NOT BE NESTED");
+
+            run(job, tokens);
         }
-    }
+    } else run(program, std::vector<std::string>(argv, argv + argc));
 
-    stbi_write_png(program.get("--output").c_str(), image.width, image.height, 3, image.data.data(), 3 * image.width);
+    if (writer.valid()) writer.get();
 }